@@ -4,86 +4,146 @@
 #include <stdio.h>
 
 
-typedef struct {
-    int id;           // ID único do anteparo
-    double x1, y1;    // Ponto inicial
-    double x2, y2;    // Ponto final
-    char* cor;        // Cor do anteparo
-} EstruturaAnteparo;
-
-static char* duplicar_string(const char* s) {
-    if (s == NULL) return NULL;
-    
-    size_t len = strlen(s) + 1;
-    char* nova = (char*)malloc(len);
-    if (nova == NULL) return NULL;
-    
-    strcpy(nova, s);
-    return nova;
+/*
+* Desenha um segmento de anteparo (linha grossa, para destacar que é anteparo).
+*/
+static void desenha_segmento(EscritorSvg svg, double x1, double y1, double x2, double y2, IdCor cor) {
+    svg_escreve_literal(svg, "\t<line x1=\"");
+    svg_escreve_numero(svg, x1, 2);
+    svg_escreve_literal(svg, "\" y1=\"");
+    svg_escreve_numero(svg, y1, 2);
+    svg_escreve_literal(svg, "\" x2=\"");
+    svg_escreve_numero(svg, x2, 2);
+    svg_escreve_literal(svg, "\" y2=\"");
+    svg_escreve_numero(svg, y2, 2);
+    svg_escreve_literal(svg, "\" stroke=\"");
+    svg_escreve_texto(svg, cores_texto(cor));
+    svg_escreve_literal(svg, "\" stroke-width=\"3\" opacity=\"0.8\" />\n");
 }
 
+// Capacidade inicial do conjunto.
+#define CAPACIDADE_INICIAL_CONJUNTO 64
+
+typedef struct {
+    int n, capacidade;
+    int* id;
+    double *x1, *y1, *x2, *y2;
+    double *dx, *dy;
+    double *xmin, *ymin, *xmax, *ymax;
+    IdCor* cor;
+    double maior_extensao;
+} EstruturaConjunto;
 
-Anteparo anteparo_cria(int id, double x1, double y1, double x2, double y2, char* cor) {
-    
-    EstruturaAnteparo* novo = (EstruturaAnteparo*)malloc(sizeof(EstruturaAnteparo));
-    if (novo == NULL) {
-        printf("Erro ao alocar anteparo\n");
+ConjuntoAnteparos conjunto_anteparos_cria() {
+    EstruturaConjunto* c = (EstruturaConjunto*) calloc(1, sizeof(EstruturaConjunto));
+    if (c == NULL) {
+        printf("Erro ao alocar conjunto de anteparos\n");
         return NULL;
     }
-    
-    novo->id = id;
-    novo->x1 = x1;
-    novo->y1 = y1;
-    novo->x2 = x2;
-    novo->y2 = y2;
-    novo->cor = duplicar_string(cor);
-    
-    return (Anteparo)novo;
+    return (ConjuntoAnteparos) c;
+}
+
+void conjunto_anteparos_destroi(ConjuntoAnteparos conj) {
+    EstruturaConjunto* c = (EstruturaConjunto*) conj;
+    if (c == NULL) return;
+    free(c->id);
+    free(c->x1); free(c->y1); free(c->x2); free(c->y2);
+    free(c->dx); free(c->dy);
+    free(c->xmin); free(c->ymin); free(c->xmax); free(c->ymax);
+    free(c->cor);
+    free(c);
+}
+
+static int expande_double(double** v, int capacidade) {
+    double* novo = (double*) realloc(*v, (size_t) capacidade * sizeof(double));
+    if (novo == NULL) return 0;
+    *v = novo;
+    return 1;
 }
 
+static int expande_conjunto(EstruturaConjunto* c) {
+    int nova = c->capacidade == 0 ? CAPACIDADE_INICIAL_CONJUNTO : c->capacidade * 2;
 
-void anteparo_destroi(Anteparo a) {
-    EstruturaAnteparo* ant = (EstruturaAnteparo*)a;
-    if (ant == NULL) return;
-    
-    if (ant->cor != NULL) {
-        free(ant->cor);
+    int* id = (int*) realloc(c->id, (size_t) nova * sizeof(int));
+    if (id == NULL) return 0;
+    c->id = id;
+    IdCor* cor = (IdCor*) realloc(c->cor, (size_t) nova * sizeof(IdCor));
+    if (cor == NULL) return 0;
+    c->cor = cor;
+
+    if (!expande_double(&c->x1, nova) || !expande_double(&c->y1, nova) ||
+        !expande_double(&c->x2, nova) || !expande_double(&c->y2, nova) ||
+        !expande_double(&c->dx, nova) || !expande_double(&c->dy, nova) ||
+        !expande_double(&c->xmin, nova) || !expande_double(&c->ymin, nova) ||
+        !expande_double(&c->xmax, nova) || !expande_double(&c->ymax, nova)) {
+        return 0;
     }
-    
-    free(ant);
+    c->capacidade = nova;
+    return 1;
 }
 
+int conjunto_anteparos_adiciona(ConjuntoAnteparos conj, int id, double x1, double y1,
+                                double x2, double y2, IdCor cor) {
+    EstruturaConjunto* c = (EstruturaConjunto*) conj;
+    if (c == NULL) return 0;
+
+    if (c->n == c->capacidade && !expande_conjunto(c)) {
+        printf("Erro ao expandir conjunto de anteparos\n");
+        return 0;
+    }
+
+    int i = c->n++;
+    c->id[i] = id;
+    c->x1[i] = x1;
+    c->y1[i] = y1;
+    c->x2[i] = x2;
+    c->y2[i] = y2;
+    c->dx[i] = x2 - x1;
+    c->dy[i] = y2 - y1;
+    c->xmin[i] = x1 < x2 ? x1 : x2;
+    c->xmax[i] = x1 > x2 ? x1 : x2;
+    c->ymin[i] = y1 < y2 ? y1 : y2;
+    c->ymax[i] = y1 > y2 ? y1 : y2;
+    c->cor[i] = cor;
 
-int anteparo_getId(Anteparo a) {
-    EstruturaAnteparo* ant = (EstruturaAnteparo*)a;
-    if (ant == NULL) return -1;
-    return ant->id;
+    double ext_x = c->xmax[i] - c->xmin[i];
+    double ext_y = c->ymax[i] - c->ymin[i];
+    if (ext_x > c->maior_extensao) c->maior_extensao = ext_x;
+    if (ext_y > c->maior_extensao) c->maior_extensao = ext_y;
+    return 1;
 }
 
-void anteparo_getCoordenadas(Anteparo a, double* x1, double* y1, 
-                             double* x2, double* y2) {
-    EstruturaAnteparo* ant = (EstruturaAnteparo*)a;
-    if (ant == NULL) return;
-    
-    if (x1) *x1 = ant->x1;
-    if (y1) *y1 = ant->y1;
-    if (x2) *x2 = ant->x2;
-    if (y2) *y2 = ant->y2;
+int conjunto_anteparos_tamanho(ConjuntoAnteparos conj) {
+    EstruturaConjunto* c = (EstruturaConjunto*) conj;
+    return c != NULL ? c->n : 0;
 }
 
-char* anteparo_getCor(Anteparo a) {
-    EstruturaAnteparo* ant = (EstruturaAnteparo*)a;
-    if (ant == NULL) return NULL;
-    return ant->cor;
+void conjunto_anteparos_vista(ConjuntoAnteparos conj, VistaAnteparos* v) {
+    EstruturaConjunto* c = (EstruturaConjunto*) conj;
+    memset(v, 0, sizeof(VistaAnteparos));
+    if (c == NULL) return;
+
+    v->n = c->n;
+    v->id = c->id;
+    v->x1 = c->x1;
+    v->y1 = c->y1;
+    v->x2 = c->x2;
+    v->y2 = c->y2;
+    v->dx = c->dx;
+    v->dy = c->dy;
+    v->xmin = c->xmin;
+    v->ymin = c->ymin;
+    v->xmax = c->xmax;
+    v->ymax = c->ymax;
+    v->cor = c->cor;
+    v->maior_extensao = c->maior_extensao;
 }
 
+void conjunto_anteparos_desenha_svg(ConjuntoAnteparos conj, EscritorSvg svg) {
+    EstruturaConjunto* c = (EstruturaConjunto*) conj;
+    if (c == NULL || svg == NULL) return;
 
-void anteparo_desenha_svg(Anteparo a, FILE* svg) {
-    EstruturaAnteparo* ant = (EstruturaAnteparo*)a;
-    if (ant == NULL || svg == NULL) return;
-    
-    // Desenhar como linha grossa (para destacar que é anteparo)
-    fprintf(svg, "\t<line x1=\"%.2f\" y1=\"%.2f\" x2=\"%.2f\" y2=\"%.2f\" "
-                 "stroke=\"%s\" stroke-width=\"3\" opacity=\"0.8\" />\n",
-            ant->x1, ant->y1, ant->x2, ant->y2, ant->cor);
-}
\ No newline at end of file
+    for (int i = 0; i < c->n; i++) {
+        desenha_segmento(svg, c->x1[i], c->y1[i], c->x2[i], c->y2[i], c->cor[i]);
+    }
+}
@@ -2,77 +2,70 @@
 #define ANTEPARO_H
 
 #include <stdio.h>
+#include "svg.h"
+#include "cores.h"
 
 /*
-* TAD Anteparo.
-* Representa um segmento de reta que bloqueia a propagação da luz ou explosão.
-* É a unidade fundamental utilizada no algoritmo de varredura angular (Scanline).
-* Possui coordenadas de início e fim, além de propriedades visuais.
+* Anteparos: segmentos de reta que bloqueiam a propagação da luz ou explosão.
+* São a unidade fundamental do algoritmo de varredura angular (Scanline).
 */
 
-typedef void* Anteparo;
-
 /*==========================*/
-/* Construtor do Anteparo   */
+/* Conjunto de Anteparos    */
 /*==========================*/
+
+/*
+* Conjunto de anteparos guardado em arrays paralelos (um por campo), na ordem de inserção.
+* É o formato consumido pela visibilidade: cada raio percorre memória contígua em vez de
+* seguir um ponteiro por anteparo. Além das coordenadas, cada anteparo já tem o vetor
+* direção (x2 - x1, y2 - y1) e a caixa envolvente calculados.
+*/
+typedef void* ConjuntoAnteparos;
+
+/*
+* Visão somente leitura dos arrays do conjunto. Vale até a próxima inserção.
+*/
+typedef struct {
+    int n;
+    const int* id;
+    const double *x1, *y1, *x2, *y2;
+    const double *dx, *dy;                     // x2 - x1, y2 - y1
+    const double *xmin, *ymin, *xmax, *ymax;   // Caixa envolvente
+    const IdCor* cor;
+    double maior_extensao;   // Maior |dx| ou |dy| do conjunto
+} VistaAnteparos;
+
 /**
- * @brief Cria um novo anteparo (segmento de reta).
- * @param id Identificador único do anteparo.
- * @param x1 Coordenada X do ponto inicial.
- * @param y1 Coordenada Y do ponto inicial.
- * @param x2 Coordenada X do ponto final.
- * @param y2 Coordenada Y do ponto final.
- * @param cor Cor do anteparo (para visualização no SVG).
- * @return Anteparo Ponteiro para a estrutura criada, ou NULL em caso de erro.
+ * @brief Cria um conjunto vazio.
+ * @return ConjuntoAnteparos O conjunto, ou NULL em caso de erro.
  */
-Anteparo anteparo_cria(int id, double x1, double y1, double x2, double y2, char* cor);
+ConjuntoAnteparos conjunto_anteparos_cria();
 
-/*==========================*/
-/* Destrutor do Anteparo    */
-/*==========================*/
 /**
- * @brief Libera a memória alocada para o anteparo.
- * @param a O anteparo a ser destruído.
+ * @brief Libera o conjunto e seus arrays.
  */
-void anteparo_destroi(Anteparo a);
-
-/*==========================*/
-/* Getters e Acessores      */
-/*==========================*/
+void conjunto_anteparos_destroi(ConjuntoAnteparos c);
 
 /**
- * @brief Retorna o identificador único do anteparo.
- * @param a O anteparo.
- * @return int O ID do anteparo.
+ * @brief Acrescenta um anteparo no fim do conjunto.
+ * @return int 1 em caso de sucesso, 0 em caso de erro.
  */
-int anteparo_getId(Anteparo a);
+int conjunto_anteparos_adiciona(ConjuntoAnteparos c, int id, double x1, double y1,
+                                double x2, double y2, IdCor cor);
 
 /**
- * @brief Recupera as coordenadas dos extremos do segmento.
- * @param a O anteparo.
- * @param x1 Ponteiro para armazenar o X inicial.
- * @param y1 Ponteiro para armazenar o Y inicial.
- * @param x2 Ponteiro para armazenar o X final.
- * @param y2 Ponteiro para armazenar o Y final.
+ * @brief Retorna o número de anteparos no conjunto.
  */
-void anteparo_getCoordenadas(Anteparo a, double* x1, double* y1, double* x2, double* y2);
+int conjunto_anteparos_tamanho(ConjuntoAnteparos c);
 
 /**
- * @brief Retorna a string de cor do anteparo.
- * @param a O anteparo.
- * @return char* A cor do anteparo.
+ * @brief Preenche a visão com os arrays atuais do conjunto.
  */
-char* anteparo_getCor(Anteparo a);
-
-/*==========================*/
-/* Funções de Desenho       */
-/*==========================*/
+void conjunto_anteparos_vista(ConjuntoAnteparos c, VistaAnteparos* v);
 
 /**
- * @brief Desenha a representação visual do anteparo em um arquivo SVG.
- * @param a O anteparo a ser desenhado.
- * @param svg O ponteiro para o arquivo SVG aberto.
+ * @brief Desenha todos os anteparos do conjunto, na ordem de inserção.
  */
-void anteparo_desenha_svg(Anteparo a, FILE* svg);
+void conjunto_anteparos_desenha_svg(ConjuntoAnteparos c, EscritorSvg svg);
 
 #endif
\ No newline at end of file
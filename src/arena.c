@@ -0,0 +1,139 @@
+#include "arena.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Tamanho padrão de cada bloco.
+#define TAM_BLOCO_ARENA (256 * 1024)
+// Alinhamento de todas as alocações (suficiente para double, ponteiros e long long).
+#define ALINHAMENTO_ARENA 16
+
+typedef struct bloco_arena {
+    struct bloco_arena* proximo;
+    size_t usado;
+    size_t capacidade;
+    // Os dados vêm logo depois do cabeçalho (alinhado)
+} BlocoArena;
+
+typedef struct {
+    BlocoArena* atual;       // Bloco onde as alocações pequenas avançam
+    BlocoArena* cheios;      // Blocos anteriores e blocos próprios de pedidos grandes
+    size_t tam_bloco;
+    size_t reservado;
+} EstruturaArena;
+
+#define TAM_CABECALHO_BLOCO \
+    ((sizeof(BlocoArena) + ALINHAMENTO_ARENA - 1) & ~(size_t)(ALINHAMENTO_ARENA - 1))
+
+static BlocoArena* novo_bloco(EstruturaArena* arena, size_t capacidade) {
+    BlocoArena* bloco = (BlocoArena*) malloc(TAM_CABECALHO_BLOCO + capacidade);
+    if (bloco == NULL) {
+        printf("Erro ao alocar bloco da arena\n");
+        return NULL;
+    }
+    bloco->proximo = NULL;
+    bloco->usado = 0;
+    bloco->capacidade = capacidade;
+    arena->reservado += capacidade;
+    return bloco;
+}
+
+static char* dados_bloco(BlocoArena* bloco) {
+    return (char*) bloco + TAM_CABECALHO_BLOCO;
+}
+
+Arena arena_cria(size_t tam_bloco) {
+    EstruturaArena* arena = (EstruturaArena*) malloc(sizeof(EstruturaArena));
+    if (arena == NULL) {
+        printf("Erro ao alocar arena\n");
+        return NULL;
+    }
+    arena->atual = NULL;
+    arena->cheios = NULL;
+    arena->tam_bloco = tam_bloco > 0 ? tam_bloco : TAM_BLOCO_ARENA;
+    arena->reservado = 0;
+    return (Arena) arena;
+}
+
+void* arena_aloca(Arena a, size_t n) {
+    EstruturaArena* arena = (EstruturaArena*) a;
+    if (arena == NULL) return NULL;
+
+    n = (n + ALINHAMENTO_ARENA - 1) & ~(size_t)(ALINHAMENTO_ARENA - 1);
+    if (n == 0) n = ALINHAMENTO_ARENA;
+
+    // Pedido grande: bloco só dele, sem descartar o espaço livre do bloco atual
+    if (n > arena->tam_bloco / 4) {
+        BlocoArena* grande = novo_bloco(arena, n);
+        if (grande == NULL) return NULL;
+        grande->usado = n;
+        grande->proximo = arena->cheios;
+        arena->cheios = grande;
+        return dados_bloco(grande);
+    }
+
+    if (arena->atual == NULL || arena->atual->capacidade - arena->atual->usado < n) {
+        BlocoArena* bloco = novo_bloco(arena, arena->tam_bloco);
+        if (bloco == NULL) return NULL;
+        if (arena->atual != NULL) {
+            arena->atual->proximo = arena->cheios;
+            arena->cheios = arena->atual;
+        }
+        arena->atual = bloco;
+    }
+
+    void* p = dados_bloco(arena->atual) + arena->atual->usado;
+    arena->atual->usado += n;
+    return p;
+}
+
+char* arena_duplica_string(Arena arena, const char* s) {
+    if (s == NULL) return NULL;
+    size_t len = strlen(s) + 1;
+    char* copia = (char*) arena_aloca(arena, len);
+    if (copia != NULL) {
+        memcpy(copia, s, len);
+    }
+    return copia;
+}
+
+size_t arena_bytes_reservados(Arena a) {
+    EstruturaArena* arena = (EstruturaArena*) a;
+    return arena != NULL ? arena->reservado : 0;
+}
+
+void arena_junta(Arena d, Arena o) {
+    EstruturaArena* destino = (EstruturaArena*) d;
+    EstruturaArena* origem = (EstruturaArena*) o;
+    if (destino == NULL || origem == NULL) return;
+
+    // O bloco atual da origem vai junto com os cheios: o destino continua no seu
+    if (origem->atual != NULL) {
+        origem->atual->proximo = origem->cheios;
+        origem->cheios = origem->atual;
+    }
+    BlocoArena* ultimo = origem->cheios;
+    if (ultimo != NULL) {
+        while (ultimo->proximo != NULL) {
+            ultimo = ultimo->proximo;
+        }
+        ultimo->proximo = destino->cheios;
+        destino->cheios = origem->cheios;
+    }
+    destino->reservado += origem->reservado;
+    free(origem);
+}
+
+void arena_destroi(Arena a) {
+    EstruturaArena* arena = (EstruturaArena*) a;
+    if (arena == NULL) return;
+
+    free(arena->atual);
+    BlocoArena* bloco = arena->cheios;
+    while (bloco != NULL) {
+        BlocoArena* proximo = bloco->proximo;
+        free(bloco);
+        bloco = proximo;
+    }
+    free(arena);
+}
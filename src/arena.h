@@ -0,0 +1,52 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+/*
+* TAD Arena de Memória.
+* Alocador por "empurrão": a memória vem de blocos grandes, cada alocação só avança um
+* índice dentro do bloco atual e nada é liberado individualmente. Tudo é devolvido de uma
+* vez em arena_destroi, com custo proporcional ao número de blocos (não de alocações).
+* Não é thread-safe: quem compartilha uma arena entre threads deve protegê-la.
+*/
+
+typedef void* Arena;
+
+/**
+ * @brief Cria uma arena vazia.
+ * @param tam_bloco Tamanho de cada bloco em bytes (0 usa o padrão).
+ * @return Arena A arena criada, ou NULL em caso de erro.
+ */
+Arena arena_cria(size_t tam_bloco);
+
+/**
+ * @brief Reserva 'n' bytes alinhados para qualquer tipo.
+ * Pedidos maiores que um quarto do bloco recebem um bloco próprio.
+ * @return void* A memória reservada, ou NULL em caso de erro.
+ */
+void* arena_aloca(Arena arena, size_t n);
+
+/**
+ * @brief Copia uma string para dentro da arena.
+ * @return char* A cópia, ou NULL se 's' for NULL ou em caso de erro.
+ */
+char* arena_duplica_string(Arena arena, const char* s);
+
+/**
+ * @brief Retorna o total de bytes reservados em blocos pela arena.
+ */
+size_t arena_bytes_reservados(Arena arena);
+
+/**
+ * @brief Passa todos os blocos de 'origem' para 'destino' e libera 'origem'.
+ * Os ponteiros obtidos de 'origem' continuam valendo e passam a ser liberados com 'destino'.
+ */
+void arena_junta(Arena destino, Arena origem);
+
+/**
+ * @brief Libera todos os blocos e a arena. Todos os ponteiros obtidos dela deixam de valer.
+ */
+void arena_destroi(Arena arena);
+
+#endif
@@ -1,5 +1,6 @@
 
 #include "arvore.h"
+#include "arvorebmais.h"
 #include <stdlib.h>
 #include <stdio.h>
 
@@ -8,18 +9,26 @@ typedef struct No {
     struct No* esq;
     struct No* dir;
     int altura;
+    int tamanho;     // Número de nós da subárvore (estatística de ordem)
 } NoArvore;
 
 typedef struct {
     NoArvore* raiz;
     FuncaoComparacaoArvore compara;
     void* contexto;  
+    NoArvore* bloco;   // Nós alocados em bloco único (arvore_cria_de_ordenado), ou NULL
+    int n_bloco;
+    ArvoreBMais bmais; // Implementação B+ (arvore_cria_bmais); NULL usa a AVL
 } EstruturaArvore;
 
 static int altura(NoArvore* no) {
     return (no == NULL) ? 0 : no->altura;
 }
 
+static int tamanho(NoArvore* no) {
+    return (no == NULL) ? 0 : no->tamanho;
+}
+
 // Retorna o maior valor entre a e b, usado na comparação de alturas.
 static int max(int a, int b) {
     return (a > b) ? a : b;
@@ -37,6 +46,13 @@ static void atualiza_altura(NoArvore* no) {
     }
 }
 
+// Corrige o tamanho da subárvore de um Node a partir dos filhos.
+static void atualiza_tamanho(NoArvore* no) {
+    if (no != NULL) {
+        no->tamanho = 1 + tamanho(no->esq) + tamanho(no->dir);
+    }
+}
+
 static NoArvore* rotacao_direita(NoArvore* y) {
     NoArvore* x = y->esq;
     NoArvore* B = x->dir;
@@ -46,6 +62,8 @@ static NoArvore* rotacao_direita(NoArvore* y) {
     
     atualiza_altura(y);
     atualiza_altura(x);
+    atualiza_tamanho(y);
+    atualiza_tamanho(x);
     
     return x;
 }
@@ -59,12 +77,15 @@ static NoArvore* rotacao_esquerda(NoArvore* x) {
     
     atualiza_altura(x);
     atualiza_altura(y);
+    atualiza_tamanho(x);
+    atualiza_tamanho(y);
     
     return y;
 }
 
 static NoArvore* balancear(NoArvore* no) {
     atualiza_altura(no);
+    atualiza_tamanho(no);
     int fb = fator_balanceamento(no);
     
     // Caso Esquerda-Esquerda
@@ -101,6 +122,63 @@ Arvore arvore_cria(FuncaoComparacaoArvore compara, void* contexto) {
     arv->raiz = NULL;
     arv->compara = compara;
     arv->contexto = contexto;
+    arv->bloco = NULL;
+    arv->n_bloco = 0;
+    arv->bmais = NULL;
+    
+    return (Arvore)arv;
+}
+
+Arvore arvore_cria_bmais(FuncaoComparacaoArvore compara, void* contexto) {
+    EstruturaArvore* arv = (EstruturaArvore*)arvore_cria(compara, contexto);
+    if (arv == NULL) return NULL;
+    
+    arv->bmais = arvorebmais_cria(compara, contexto);
+    if (arv->bmais == NULL) {
+        free(arv);
+        return NULL;
+    }
+    
+    return (Arvore)arv;
+}
+
+// Monta a subárvore de array[inicio..fim] tomando a mediana como raiz.
+// Os nós são retirados do bloco em ordem e as alturas calculadas de baixo para cima.
+static NoArvore* constroi_balanceada(void** array, int inicio, int fim, NoArvore* bloco, int* proximo) {
+    if (inicio > fim) return NULL;
+    
+    int meio = inicio + (fim - inicio) / 2;
+    
+    NoArvore* esq = constroi_balanceada(array, inicio, meio - 1, bloco, proximo);
+    
+    NoArvore* no = &bloco[(*proximo)++];
+    no->elemento = array[meio];
+    no->esq = esq;
+    no->dir = constroi_balanceada(array, meio + 1, fim, bloco, proximo);
+    atualiza_altura(no);
+    atualiza_tamanho(no);
+    
+    return no;
+}
+
+Arvore arvore_cria_de_ordenado(void** array, int n, FuncaoComparacaoArvore compara, void* contexto) {
+    EstruturaArvore* arv = (EstruturaArvore*)arvore_cria(compara, contexto);
+    if (arv == NULL) return NULL;
+    
+    if (array == NULL || n <= 0) {
+        return (Arvore)arv;
+    }
+    
+    arv->bloco = (NoArvore*)malloc(n * sizeof(NoArvore));
+    if (arv->bloco == NULL) {
+        printf("Erro ao alocar bloco de nos em arvore_cria_de_ordenado\n");
+        free(arv);
+        return NULL;
+    }
+    arv->n_bloco = n;
+    
+    int proximo = 0;
+    arv->raiz = constroi_balanceada(array, 0, n - 1, arv->bloco, &proximo);
     
     return (Arvore)arv;
 }
@@ -112,6 +190,7 @@ static NoArvore* inserir_no(NoArvore* no, void* elemento, FuncaoComparacaoArvore
         novo->esq = NULL;
         novo->dir = NULL;
         novo->altura = 1;
+        novo->tamanho = 1;
         return novo;
     }
     
@@ -133,6 +212,11 @@ void arvore_insere(Arvore arv, void* elemento) {
     EstruturaArvore* arvore = (EstruturaArvore*)arv;
     if (arvore == NULL || elemento == NULL) return;
     
+    if (arvore->bmais != NULL) {
+        arvorebmais_insere(arvore->bmais, elemento);
+        return;
+    }
+    
     arvore->raiz = inserir_no(arvore->raiz, elemento, arvore->compara, arvore->contexto);
 }
 
@@ -154,6 +238,8 @@ void* arvore_busca(Arvore arv, void* elemento) {
     EstruturaArvore* arvore = (EstruturaArvore*)arv;
     if (arvore == NULL) return NULL;
     
+    if (arvore->bmais != NULL) return arvorebmais_busca(arvore->bmais, elemento);
+    
     NoArvore* no = buscar_no(arvore->raiz, elemento, arvore->compara, arvore->contexto);
     
     return (no != NULL) ? no->elemento : NULL;
@@ -166,31 +252,41 @@ static NoArvore* achar_minimo(NoArvore* no) {
     return no;
 }
 
-static NoArvore* remover_no(NoArvore* no, void* elemento, FuncaoComparacaoArvore compara, void* contexto,void** elemento_removido) {
+// Libera um nó, exceto quando ele pertence ao bloco da carga em lote.
+static void libera_no(EstruturaArvore* arvore, NoArvore* no) {
+    if (arvore->bloco != NULL && no >= arvore->bloco && no < arvore->bloco + arvore->n_bloco) {
+        return;
+    }
+    free(no);
+}
+
+static NoArvore* remover_no(EstruturaArvore* arvore, NoArvore* no, void* elemento, void** elemento_removido) {
     if (no == NULL) return NULL;
     
-    int cmp = compara(elemento, no->elemento, contexto);
+    int cmp = arvore->compara(elemento, no->elemento, arvore->contexto);
     
     if (cmp < 0) {
-        no->esq = remover_no(no->esq, elemento, compara, contexto, elemento_removido);
+        no->esq = remover_no(arvore, no->esq, elemento, elemento_removido);
     } else if (cmp > 0) {
-        no->dir = remover_no(no->dir, elemento, compara, contexto, elemento_removido);
+        no->dir = remover_no(arvore, no->dir, elemento, elemento_removido);
     } else {
         *elemento_removido = no->elemento;
         
         if (no->esq == NULL) {
             NoArvore* temp = no->dir;
-            free(no);
+            libera_no(arvore, no);
             return temp;
         } else if (no->dir == NULL) {
             NoArvore* temp = no->esq;
-            free(no);
+            libera_no(arvore, no);
             return temp;
         }
         
+        // O sucessor ocupa o lugar do nó; sua remoção não deve sobrescrever o elemento devolvido.
         NoArvore* temp = achar_minimo(no->dir);
+        void* sucessor_removido = NULL;
         no->elemento = temp->elemento;
-        no->dir = remover_no(no->dir, temp->elemento, compara, contexto, elemento_removido);
+        no->dir = remover_no(arvore, no->dir, temp->elemento, &sucessor_removido);
     }
     
     return balancear(no);
@@ -200,29 +296,110 @@ void* arvore_remove(Arvore arv, void* elemento) {
     EstruturaArvore* arvore = (EstruturaArvore*)arv;
     if (arvore == NULL) return NULL;
     
+    if (arvore->bmais != NULL) return arvorebmais_remove(arvore->bmais, elemento);
+    
     void* elemento_removido = NULL;
-    arvore->raiz = remover_no(arvore->raiz, elemento, arvore->compara, arvore->contexto,&elemento_removido);
+    arvore->raiz = remover_no(arvore, arvore->raiz, elemento, &elemento_removido);
     
     return elemento_removido;
 }
 
-static void destruir_no(NoArvore* no) {
+static void destruir_no(EstruturaArvore* arvore, NoArvore* no) {
     if (no == NULL) return;
-    destruir_no(no->esq);
-    destruir_no(no->dir);
-    free(no);
+    destruir_no(arvore, no->esq);
+    destruir_no(arvore, no->dir);
+    libera_no(arvore, no);
 }
 
 void arvore_destroi(Arvore arv) {
     EstruturaArvore* arvore = (EstruturaArvore*)arv;
     if (arvore == NULL) return;
     
-    destruir_no(arvore->raiz);
+    arvorebmais_destroi(arvore->bmais);
+    destruir_no(arvore, arvore->raiz);
+    free(arvore->bloco);
     free(arvore);
 }
 
 int arvore_altura(Arvore arv) {
     EstruturaArvore* arvore = (EstruturaArvore*)arv;
     if (arvore == NULL) return 0;
+    if (arvore->bmais != NULL) return arvorebmais_altura(arvore->bmais);
     return altura(arvore->raiz);
-}
\ No newline at end of file
+}
+
+int arvore_tamanho(Arvore arv) {
+    EstruturaArvore* arvore = (EstruturaArvore*)arv;
+    if (arvore == NULL) return 0;
+    if (arvore->bmais != NULL) return arvorebmais_tamanho(arvore->bmais);
+    return tamanho(arvore->raiz);
+}
+
+// ========== ESTATÍSTICAS DE ORDEM ==========
+
+// Conta os elementos estritamente menores (ou menores ou iguais, se 'inclusivo') que o dado.
+static int conta_menores(NoArvore* no, void* elemento, int inclusivo, FuncaoComparacaoArvore compara, void* contexto) {
+    int contagem = 0;
+    
+    while (no != NULL) {
+        int cmp = compara(elemento, no->elemento, contexto);
+        
+        if (cmp < 0 || (cmp == 0 && !inclusivo)) {
+            no = no->esq;
+        } else {
+            contagem += tamanho(no->esq) + 1;
+            no = no->dir;
+        }
+    }
+    
+    return contagem;
+}
+
+int arvore_rank(Arvore arv, void* elemento) {
+    EstruturaArvore* arvore = (EstruturaArvore*)arv;
+    if (arvore == NULL || elemento == NULL) return 0;
+    
+    if (arvore->bmais != NULL) return arvorebmais_rank(arvore->bmais, elemento);
+    
+    return conta_menores(arvore->raiz, elemento, 0, arvore->compara, arvore->contexto);
+}
+
+void* arvore_seleciona(Arvore arv, int k) {
+    EstruturaArvore* arvore = (EstruturaArvore*)arv;
+    if (arvore == NULL) return NULL;
+    
+    if (arvore->bmais != NULL) return arvorebmais_seleciona(arvore->bmais, k);
+    
+    if (k < 0 || k >= tamanho(arvore->raiz)) return NULL;
+    
+    NoArvore* no = arvore->raiz;
+    
+    while (no != NULL) {
+        int t_esq = tamanho(no->esq);
+        
+        if (k < t_esq) {
+            no = no->esq;
+        } else if (k > t_esq) {
+            k -= t_esq + 1;
+            no = no->dir;
+        } else {
+            return no->elemento;
+        }
+    }
+    
+    return NULL;
+}
+
+int arvore_conta_intervalo(Arvore arv, void* lo, void* hi) {
+    EstruturaArvore* arvore = (EstruturaArvore*)arv;
+    if (arvore == NULL || lo == NULL || hi == NULL) return 0;
+    
+    if (arvore->compara(lo, hi, arvore->contexto) > 0) return 0;
+    
+    if (arvore->bmais != NULL) return arvorebmais_percorre_intervalo(arvore->bmais, lo, hi, NULL, NULL);
+    
+    int ate_hi = conta_menores(arvore->raiz, hi, 1, arvore->compara, arvore->contexto);
+    int antes_lo = conta_menores(arvore->raiz, lo, 0, arvore->compara, arvore->contexto);
+    
+    return ate_hi - antes_lo;
+}
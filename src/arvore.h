@@ -29,6 +29,28 @@ typedef int (*FuncaoComparacaoArvore)(void* a, void* b, void* contexto);
  */
 Arvore arvore_cria(FuncaoComparacaoArvore compara, void* contexto);
 
+/**
+ * @brief Cria uma árvore com a mesma interface, mas implementada como Árvore B+ (ver arvorebmais.h).
+ * Indicada para índices muito grandes: nós largos e folhas encadeadas reduzem saltos de ponteiro.
+ * Nesta variante, arvore_rank e arvore_seleciona percorrem as folhas (O(n / ARVOREBMAIS_ORDEM))
+ * e arvore_conta_intervalo custa O(log n + k).
+ * @param compara Função de callback para comparar dois elementos.
+ * @param contexto Ponteiro genérico passado para a função de comparação (opcional).
+ * @return Arvore A nova árvore criada, ou NULL em caso de erro.
+ */
+Arvore arvore_cria_bmais(FuncaoComparacaoArvore compara, void* contexto);
+
+/**
+ * @brief Cria uma árvore perfeitamente balanceada a partir de um array já ordenado, em O(n).
+ * Todos os nós vêm de uma única alocação; inserções posteriores usam nós avulsos normalmente.
+ * @param array Array de elementos em ordem estritamente crescente (segundo 'compara'), sem repetidos.
+ * @param n Número de elementos no array.
+ * @param compara Função de callback para comparar dois elementos.
+ * @param contexto Ponteiro genérico passado para a função de comparação (opcional).
+ * @return Arvore A nova árvore criada, ou NULL em caso de erro.
+ */
+Arvore arvore_cria_de_ordenado(void** array, int n, FuncaoComparacaoArvore compara, void* contexto);
+
 /**
  * @brief Destrói a árvore e libera seus nós internos.
  * @param arv A árvore a ser destruída.
@@ -92,4 +114,44 @@ void* arvore_predecessor(Arvore arv, void* elemento);
  */
 int arvore_altura(Arvore arv);
 
+/**
+ * @brief Retorna o número de elementos armazenados na árvore.
+ * @param arv A árvore.
+ * @return int O número de elementos (0 se vazia).
+ */
+int arvore_tamanho(Arvore arv);
+
+/*==========================*/
+/* Estatísticas de Ordem    */
+/*==========================*/
+/*
+* Cada nó guarda o tamanho da sua subárvore, mantido nas rotações e no
+* rebalanceamento. Isso permite responder às consultas abaixo em O(log n).
+*/
+
+/**
+ * @brief Calcula a posição (rank) de um elemento na ordem da árvore.
+ * @param arv A árvore.
+ * @param elemento O elemento de referência (não precisa estar na árvore).
+ * @return int Quantidade de elementos estritamente menores que o dado.
+ */
+int arvore_rank(Arvore arv, void* elemento);
+
+/**
+ * @brief Seleciona o k-ésimo menor elemento da árvore.
+ * @param arv A árvore.
+ * @param k Posição desejada, começando em 0.
+ * @return void* O elemento na posição k, ou NULL se k estiver fora do intervalo.
+ */
+void* arvore_seleciona(Arvore arv, int k);
+
+/**
+ * @brief Conta quantos elementos estão no intervalo fechado [lo, hi].
+ * @param arv A árvore.
+ * @param lo Limite inferior (inclusivo).
+ * @param hi Limite superior (inclusivo).
+ * @return int Quantidade de elementos no intervalo (0 se lo > hi).
+ */
+int arvore_conta_intervalo(Arvore arv, void* lo, void* hi);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,443 @@
+#include "arvorebmais.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#define ORDEM ARVOREBMAIS_ORDEM
+#define MINIMO (ORDEM / 2)
+
+/*
+* Nas folhas, 'chaves' são os próprios elementos e 'prox' aponta para a folha seguinte.
+* Nos nós internos, chaves[i] separa filhos[i] (< chave) de filhos[i+1] (>= chave).
+* Há uma posição extra nos arrays para o transbordo temporário antes da divisão.
+*/
+typedef struct NoBMais {
+    int folha;
+    int n;
+    void* chaves[ORDEM + 1];
+    struct NoBMais* filhos[ORDEM + 2];
+    struct NoBMais* prox;
+} NoBMais;
+
+typedef struct {
+    NoBMais* raiz;
+    FuncaoComparacaoArvore compara;
+    void* contexto;
+    int tamanho;
+} EstruturaArvoreBMais;
+
+static NoBMais* cria_no(int folha) {
+    NoBMais* no = (NoBMais*)malloc(sizeof(NoBMais));
+    if (no == NULL) {
+        printf("Erro ao alocar no da arvore B+\n");
+        return NULL;
+    }
+    no->folha = folha;
+    no->n = 0;
+    no->prox = NULL;
+    return no;
+}
+
+// Primeira posição cuja chave é >= elemento (busca binária dentro do nó).
+static int limite_inferior(EstruturaArvoreBMais* arv, NoBMais* no, void* elemento) {
+    int ini = 0, fim = no->n;
+    while (ini < fim) {
+        int meio = (ini + fim) / 2;
+        if (arv->compara(no->chaves[meio], elemento, arv->contexto) < 0) {
+            ini = meio + 1;
+        } else {
+            fim = meio;
+        }
+    }
+    return ini;
+}
+
+// Índice do filho onde o elemento deve estar: número de separadores <= elemento.
+static int indice_filho(EstruturaArvoreBMais* arv, NoBMais* no, void* elemento) {
+    int ini = 0, fim = no->n;
+    while (ini < fim) {
+        int meio = (ini + fim) / 2;
+        if (arv->compara(no->chaves[meio], elemento, arv->contexto) <= 0) {
+            ini = meio + 1;
+        } else {
+            fim = meio;
+        }
+    }
+    return ini;
+}
+
+static NoBMais* acha_folha(EstruturaArvoreBMais* arv, void* elemento) {
+    NoBMais* no = arv->raiz;
+    while (no != NULL && !no->folha) {
+        no = no->filhos[indice_filho(arv, no, elemento)];
+    }
+    return no;
+}
+
+static NoBMais* folha_mais_a_esquerda(EstruturaArvoreBMais* arv) {
+    NoBMais* no = arv->raiz;
+    while (no != NULL && !no->folha) {
+        no = no->filhos[0];
+    }
+    return no;
+}
+
+/*==========================*/
+/* Construtor e Destrutor   */
+/*==========================*/
+
+ArvoreBMais arvorebmais_cria(FuncaoComparacaoArvore compara, void* contexto) {
+    EstruturaArvoreBMais* arv = (EstruturaArvoreBMais*)malloc(sizeof(EstruturaArvoreBMais));
+    if (arv == NULL) {
+        printf("Erro ao alocar arvore B+ em arvorebmais_cria\n");
+        return NULL;
+    }
+
+    arv->raiz = NULL;
+    arv->compara = compara;
+    arv->contexto = contexto;
+    arv->tamanho = 0;
+
+    return (ArvoreBMais)arv;
+}
+
+static void destruir_no(NoBMais* no) {
+    if (no == NULL) return;
+    if (!no->folha) {
+        for (int i = 0; i <= no->n; i++) {
+            destruir_no(no->filhos[i]);
+        }
+    }
+    free(no);
+}
+
+void arvorebmais_destroi(ArvoreBMais a) {
+    EstruturaArvoreBMais* arv = (EstruturaArvoreBMais*)a;
+    if (arv == NULL) return;
+
+    destruir_no(arv->raiz);
+    free(arv);
+}
+
+/*==========================*/
+/* Inserção                 */
+/*==========================*/
+
+// Divide um nó com ORDEM + 1 chaves. Devolve o novo irmão direito e o separador a subir.
+static NoBMais* dividir(NoBMais* no, void** separador) {
+    NoBMais* novo = cria_no(no->folha);
+    if (novo == NULL) return NULL;
+
+    int esq = (ORDEM + 1) / 2;
+
+    if (no->folha) {
+        novo->n = no->n - esq;
+        memcpy(novo->chaves, no->chaves + esq, novo->n * sizeof(void*));
+        no->n = esq;
+
+        novo->prox = no->prox;
+        no->prox = novo;
+        *separador = novo->chaves[0];
+    } else {
+        // A chave do meio sobe e não fica em nenhum dos dois lados.
+        *separador = no->chaves[esq];
+        novo->n = no->n - esq - 1;
+        memcpy(novo->chaves, no->chaves + esq + 1, novo->n * sizeof(void*));
+        memcpy(novo->filhos, no->filhos + esq + 1, (novo->n + 1) * sizeof(NoBMais*));
+        no->n = esq;
+    }
+
+    return novo;
+}
+
+// Insere recursivamente. Retorna o irmão criado caso 'no' tenha sido dividido, ou NULL.
+static NoBMais* inserir_no(EstruturaArvoreBMais* arv, NoBMais* no, void* elemento, void** separador, int* inseriu) {
+    if (no->folha) {
+        int pos = limite_inferior(arv, no, elemento);
+        if (pos < no->n && arv->compara(no->chaves[pos], elemento, arv->contexto) == 0) {
+            return NULL;
+        }
+
+        memmove(no->chaves + pos + 1, no->chaves + pos, (no->n - pos) * sizeof(void*));
+        no->chaves[pos] = elemento;
+        no->n++;
+        *inseriu = 1;
+    } else {
+        int i = indice_filho(arv, no, elemento);
+        void* sep_filho;
+        NoBMais* irmao = inserir_no(arv, no->filhos[i], elemento, &sep_filho, inseriu);
+        if (irmao == NULL) return NULL;
+
+        memmove(no->chaves + i + 1, no->chaves + i, (no->n - i) * sizeof(void*));
+        memmove(no->filhos + i + 2, no->filhos + i + 1, (no->n - i) * sizeof(NoBMais*));
+        no->chaves[i] = sep_filho;
+        no->filhos[i + 1] = irmao;
+        no->n++;
+    }
+
+    if (no->n > ORDEM) {
+        return dividir(no, separador);
+    }
+    return NULL;
+}
+
+void arvorebmais_insere(ArvoreBMais a, void* elemento) {
+    EstruturaArvoreBMais* arv = (EstruturaArvoreBMais*)a;
+    if (arv == NULL || elemento == NULL) return;
+
+    if (arv->raiz == NULL) {
+        arv->raiz = cria_no(1);
+        if (arv->raiz == NULL) return;
+    }
+
+    void* separador;
+    int inseriu = 0;
+    NoBMais* irmao = inserir_no(arv, arv->raiz, elemento, &separador, &inseriu);
+
+    if (irmao != NULL) {
+        NoBMais* nova_raiz = cria_no(0);
+        if (nova_raiz == NULL) return;
+        nova_raiz->n = 1;
+        nova_raiz->chaves[0] = separador;
+        nova_raiz->filhos[0] = arv->raiz;
+        nova_raiz->filhos[1] = irmao;
+        arv->raiz = nova_raiz;
+    }
+
+    if (inseriu) arv->tamanho++;
+}
+
+/*==========================*/
+/* Busca                    */
+/*==========================*/
+
+void* arvorebmais_busca(ArvoreBMais a, void* elemento) {
+    EstruturaArvoreBMais* arv = (EstruturaArvoreBMais*)a;
+    if (arv == NULL || elemento == NULL) return NULL;
+
+    NoBMais* folha = acha_folha(arv, elemento);
+    if (folha == NULL) return NULL;
+
+    int pos = limite_inferior(arv, folha, elemento);
+    if (pos < folha->n && arv->compara(folha->chaves[pos], elemento, arv->contexto) == 0) {
+        return folha->chaves[pos];
+    }
+    return NULL;
+}
+
+/*==========================*/
+/* Remoção                  */
+/*==========================*/
+
+// Passa uma chave do irmão esquerdo para filhos[i].
+static void empresta_da_esquerda(NoBMais* pai, int i) {
+    NoBMais* filho = pai->filhos[i];
+    NoBMais* esq = pai->filhos[i - 1];
+
+    memmove(filho->chaves + 1, filho->chaves, filho->n * sizeof(void*));
+    if (filho->folha) {
+        filho->chaves[0] = esq->chaves[esq->n - 1];
+        pai->chaves[i - 1] = filho->chaves[0];
+    } else {
+        memmove(filho->filhos + 1, filho->filhos, (filho->n + 1) * sizeof(NoBMais*));
+        filho->chaves[0] = pai->chaves[i - 1];
+        filho->filhos[0] = esq->filhos[esq->n];
+        pai->chaves[i - 1] = esq->chaves[esq->n - 1];
+    }
+    filho->n++;
+    esq->n--;
+}
+
+// Passa uma chave do irmão direito para filhos[i].
+static void empresta_da_direita(NoBMais* pai, int i) {
+    NoBMais* filho = pai->filhos[i];
+    NoBMais* dir = pai->filhos[i + 1];
+
+    if (filho->folha) {
+        filho->chaves[filho->n] = dir->chaves[0];
+        memmove(dir->chaves, dir->chaves + 1, (dir->n - 1) * sizeof(void*));
+        dir->n--;
+        pai->chaves[i] = dir->chaves[0];
+    } else {
+        filho->chaves[filho->n] = pai->chaves[i];
+        filho->filhos[filho->n + 1] = dir->filhos[0];
+        pai->chaves[i] = dir->chaves[0];
+        memmove(dir->chaves, dir->chaves + 1, (dir->n - 1) * sizeof(void*));
+        memmove(dir->filhos, dir->filhos + 1, dir->n * sizeof(NoBMais*));
+        dir->n--;
+    }
+    filho->n++;
+}
+
+// Junta filhos[i + 1] em filhos[i] e remove o separador entre eles do pai.
+static void junta(NoBMais* pai, int i) {
+    NoBMais* esq = pai->filhos[i];
+    NoBMais* dir = pai->filhos[i + 1];
+
+    if (esq->folha) {
+        memcpy(esq->chaves + esq->n, dir->chaves, dir->n * sizeof(void*));
+        esq->n += dir->n;
+        esq->prox = dir->prox;
+    } else {
+        esq->chaves[esq->n] = pai->chaves[i];
+        memcpy(esq->chaves + esq->n + 1, dir->chaves, dir->n * sizeof(void*));
+        memcpy(esq->filhos + esq->n + 1, dir->filhos, (dir->n + 1) * sizeof(NoBMais*));
+        esq->n += dir->n + 1;
+    }
+    free(dir);
+
+    memmove(pai->chaves + i, pai->chaves + i + 1, (pai->n - i - 1) * sizeof(void*));
+    memmove(pai->filhos + i + 1, pai->filhos + i + 2, (pai->n - i - 1) * sizeof(NoBMais*));
+    pai->n--;
+}
+
+// Restaura o mínimo de chaves de filhos[i] emprestando de um irmão ou juntando.
+static void corrige_filho(NoBMais* pai, int i) {
+    if (i > 0 && pai->filhos[i - 1]->n > MINIMO) {
+        empresta_da_esquerda(pai, i);
+    } else if (i < pai->n && pai->filhos[i + 1]->n > MINIMO) {
+        empresta_da_direita(pai, i);
+    } else if (i > 0) {
+        junta(pai, i - 1);
+    } else {
+        junta(pai, i);
+    }
+}
+
+static void* remover_no(EstruturaArvoreBMais* arv, NoBMais* no, void* elemento) {
+    if (no->folha) {
+        int pos = limite_inferior(arv, no, elemento);
+        if (pos >= no->n || arv->compara(no->chaves[pos], elemento, arv->contexto) != 0) {
+            return NULL;
+        }
+
+        void* removido = no->chaves[pos];
+        memmove(no->chaves + pos, no->chaves + pos + 1, (no->n - pos - 1) * sizeof(void*));
+        no->n--;
+        return removido;
+    }
+
+    int i = indice_filho(arv, no, elemento);
+    void* removido = remover_no(arv, no->filhos[i], elemento);
+
+    if (removido != NULL && no->filhos[i]->n < MINIMO) {
+        corrige_filho(no, i);
+    }
+    return removido;
+}
+
+/*
+* Os separadores apontam para elementos das folhas. Depois da remoção, o elemento
+* removido ainda pode estar como separador em algum nó do caminho até ele (e o chamador
+* costuma liberá-lo em seguida); cada ocorrência é trocada pelo menor elemento da
+* subárvore à direita, que continua separando os dois lados.
+*/
+static void substitui_separador(EstruturaArvoreBMais* arv, void* elemento, void* removido) {
+    NoBMais* no = arv->raiz;
+    while (no != NULL && !no->folha) {
+        int i = indice_filho(arv, no, elemento);
+        if (i > 0 && no->chaves[i - 1] == removido) {
+            NoBMais* menor = no->filhos[i];
+            while (!menor->folha) {
+                menor = menor->filhos[0];
+            }
+            no->chaves[i - 1] = menor->chaves[0];
+        }
+        no = no->filhos[i];
+    }
+}
+
+void* arvorebmais_remove(ArvoreBMais a, void* elemento) {
+    EstruturaArvoreBMais* arv = (EstruturaArvoreBMais*)a;
+    if (arv == NULL || arv->raiz == NULL || elemento == NULL) return NULL;
+
+    void* removido = remover_no(arv, arv->raiz, elemento);
+    if (removido == NULL) return NULL;
+
+    arv->tamanho--;
+
+    // A raiz pode ficar com menos que o mínimo; se esvaziar, a árvore perde um nível.
+    NoBMais* raiz = arv->raiz;
+    if (raiz->n == 0) {
+        arv->raiz = raiz->folha ? NULL : raiz->filhos[0];
+        free(raiz);
+    }
+
+    substitui_separador(arv, elemento, removido);
+    return removido;
+}
+
+/*==========================*/
+/* Consultas de Intervalo   */
+/*==========================*/
+
+int arvorebmais_percorre_intervalo(ArvoreBMais a, void* lo, void* hi, FuncaoVisitaArvore visita, void* dados) {
+    EstruturaArvoreBMais* arv = (EstruturaArvoreBMais*)a;
+    if (arv == NULL || lo == NULL || hi == NULL) return 0;
+
+    NoBMais* folha = acha_folha(arv, lo);
+    if (folha == NULL) return 0;
+
+    int contagem = 0;
+    int pos = limite_inferior(arv, folha, lo);
+
+    while (folha != NULL) {
+        for (; pos < folha->n; pos++) {
+            if (arv->compara(folha->chaves[pos], hi, arv->contexto) > 0) {
+                return contagem;
+            }
+            if (visita != NULL) visita(folha->chaves[pos], dados);
+            contagem++;
+        }
+        folha = folha->prox;
+        pos = 0;
+    }
+
+    return contagem;
+}
+
+int arvorebmais_rank(ArvoreBMais a, void* elemento) {
+    EstruturaArvoreBMais* arv = (EstruturaArvoreBMais*)a;
+    if (arv == NULL || elemento == NULL) return 0;
+
+    int contagem = 0;
+    for (NoBMais* folha = folha_mais_a_esquerda(arv); folha != NULL; folha = folha->prox) {
+        if (folha->n > 0 && arv->compara(folha->chaves[folha->n - 1], elemento, arv->contexto) >= 0) {
+            return contagem + limite_inferior(arv, folha, elemento);
+        }
+        contagem += folha->n;
+    }
+    return contagem;
+}
+
+void* arvorebmais_seleciona(ArvoreBMais a, int k) {
+    EstruturaArvoreBMais* arv = (EstruturaArvoreBMais*)a;
+    if (arv == NULL || k < 0 || k >= arv->tamanho) return NULL;
+
+    for (NoBMais* folha = folha_mais_a_esquerda(arv); folha != NULL; folha = folha->prox) {
+        if (k < folha->n) return folha->chaves[k];
+        k -= folha->n;
+    }
+    return NULL;
+}
+
+/*==========================*/
+/* Auxiliares               */
+/*==========================*/
+
+int arvorebmais_altura(ArvoreBMais a) {
+    EstruturaArvoreBMais* arv = (EstruturaArvoreBMais*)a;
+    if (arv == NULL) return 0;
+
+    int altura = 0;
+    for (NoBMais* no = arv->raiz; no != NULL; no = no->folha ? NULL : no->filhos[0]) {
+        altura++;
+    }
+    return altura;
+}
+
+int arvorebmais_tamanho(ArvoreBMais a) {
+    EstruturaArvoreBMais* arv = (EstruturaArvoreBMais*)a;
+    if (arv == NULL) return 0;
+    return arv->tamanho;
+}
@@ -0,0 +1,111 @@
+#ifndef ARVOREBMAIS_H
+#define ARVOREBMAIS_H
+
+#include "arvore.h"
+
+/*
+* TAD Árvore B+.
+* Variante da árvore de busca voltada a índices muito grandes (ex: ids de milhões de formas).
+* Cada nó guarda até ARVOREBMAIS_ORDEM chaves em um array contíguo, então uma busca
+* faz poucos saltos de ponteiro e percorre chaves vizinhas na mesma linha de cache.
+* Os elementos ficam todos nas folhas, que são encadeadas para varreduras por intervalo.
+* Usa a mesma FuncaoComparacaoArvore (com contexto) do TAD Arvore; para trocar de
+* implementação basta criar a árvore com arvore_cria_bmais (ver arvore.h).
+*/
+
+typedef void* ArvoreBMais;
+
+/*
+* Número máximo de chaves por nó. Nós não-raiz mantêm pelo menos metade disso.
+*/
+#define ARVOREBMAIS_ORDEM 32
+
+/*
+* Função chamada para cada elemento visitado em uma varredura por intervalo.
+*/
+typedef void (*FuncaoVisitaArvore)(void* elemento, void* dados);
+
+/*==========================*/
+/* Construtor e Destrutor   */
+/*==========================*/
+/**
+ * @brief Cria uma árvore B+ vazia.
+ * @param compara Função de callback para comparar dois elementos.
+ * @param contexto Ponteiro genérico passado para a função de comparação (opcional).
+ * @return ArvoreBMais A nova árvore criada, ou NULL em caso de erro.
+ */
+ArvoreBMais arvorebmais_cria(FuncaoComparacaoArvore compara, void* contexto);
+
+/**
+ * @brief Destrói a árvore e libera seus nós internos (os elementos não são liberados).
+ * @param arv A árvore a ser destruída.
+ */
+void arvorebmais_destroi(ArvoreBMais arv);
+
+/*==========================*/
+/* Operações Principais     */
+/*==========================*/
+/**
+ * @brief Insere um elemento. Elementos iguais a um já existente são ignorados.
+ * @param arv A árvore.
+ * @param elemento O dado a ser inserido.
+ */
+void arvorebmais_insere(ArvoreBMais arv, void* elemento);
+
+/**
+ * @brief Remove um elemento da árvore.
+ * @param arv A árvore.
+ * @param elemento O elemento a ser removido (usando a função de comparação para achar).
+ * @return void* O ponteiro para o dado removido, ou NULL se não encontrado.
+ */
+void* arvorebmais_remove(ArvoreBMais arv, void* elemento);
+
+/**
+ * @brief Busca um elemento na árvore.
+ * @param arv A árvore.
+ * @param elemento O elemento chave de busca.
+ * @return void* O elemento encontrado na árvore, ou NULL.
+ */
+void* arvorebmais_busca(ArvoreBMais arv, void* elemento);
+
+/*==========================*/
+/* Consultas de Intervalo   */
+/*==========================*/
+/**
+ * @brief Visita, em ordem crescente, todos os elementos no intervalo fechado [lo, hi].
+ * Desce até a folha de 'lo' e segue o encadeamento das folhas.
+ * @param arv A árvore.
+ * @param lo Limite inferior (inclusivo).
+ * @param hi Limite superior (inclusivo).
+ * @param visita Função chamada para cada elemento (pode ser NULL para apenas contar).
+ * @param dados Ponteiro repassado para 'visita'.
+ * @return int Quantidade de elementos visitados.
+ */
+int arvorebmais_percorre_intervalo(ArvoreBMais arv, void* lo, void* hi, FuncaoVisitaArvore visita, void* dados);
+
+/**
+ * @brief Calcula quantos elementos são estritamente menores que o dado.
+ * Percorre as folhas encadeadas: custo O(n / ARVOREBMAIS_ORDEM).
+ */
+int arvorebmais_rank(ArvoreBMais arv, void* elemento);
+
+/**
+ * @brief Retorna o k-ésimo menor elemento (começando em 0), ou NULL se fora do intervalo.
+ * Percorre as folhas encadeadas: custo O(n / ARVOREBMAIS_ORDEM).
+ */
+void* arvorebmais_seleciona(ArvoreBMais arv, int k);
+
+/*==========================*/
+/* Auxiliares               */
+/*==========================*/
+/**
+ * @brief Retorna o número de níveis da árvore (0 se vazia).
+ */
+int arvorebmais_altura(ArvoreBMais arv);
+
+/**
+ * @brief Retorna o número de elementos armazenados.
+ */
+int arvorebmais_tamanho(ArvoreBMais arv);
+
+#endif
@@ -0,0 +1,314 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "../ordenacao.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+/*
+* Benchmark dos algoritmos de ordenacao.c e calibração dos limites do Insertion Sort.
+* Mede ns/elemento em entradas aleatórias, ordenadas, invertidas e com poucos valores
+* distintos, para vários tamanhos de array e de elemento. Ao final escolhe os limites
+* do mergesort e do pdqsort com menor custo relativo somado e os grava em um header.
+* Uso: bench_ordenacao [saida.h]   (executado por 'make bench-sort')
+*/
+
+// Cada medição ordena pelo menos isso de elementos no total (repetindo arrays pequenos).
+#define ELEMENTOS_POR_MEDICAO 200000
+// Tamanho dos arrays usados na calibração dos limites.
+#define N_CALIBRACAO 100000
+// Maior tamanho em que o Insertion Sort puro é medido.
+#define N_MAX_INSERCAO 1000
+
+typedef struct {
+    double chave;
+    double x, y;
+} Registro;
+
+static int compara_int(const void* a, const void* b) {
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+static int compara_double(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static int compara_registro(const void* a, const void* b) {
+    double x = ((const Registro*)a)->chave, y = ((const Registro*)b)->chave;
+    return (x > y) - (x < y);
+}
+
+typedef struct {
+    const char* nome;
+    int tam;
+    FuncaoComparacao compara;
+} TipoElemento;
+
+static const TipoElemento tipos[] = {
+    {"int", sizeof(int), compara_int},
+    {"double", sizeof(double), compara_double},
+    {"registro", sizeof(Registro), compara_registro},
+};
+#define N_TIPOS ((int)(sizeof(tipos) / sizeof(tipos[0])))
+
+static const char* distribuicoes[] = {"aleatorio", "ordenado", "invertido", "poucos_unicos"};
+#define N_DISTRIBUICOES 4
+
+static const int tamanhos[] = {1000, 10000, 100000};
+#define N_TAMANHOS ((int)(sizeof(tamanhos) / sizeof(tamanhos[0])))
+
+static const int limites_mergesort[] = {4, 8, 12, 16, 24, 32, 48, 64};
+#define N_LIMITES_MERGESORT ((int)(sizeof(limites_mergesort) / sizeof(limites_mergesort[0])))
+
+static const int limites_pdq[] = {8, 12, 16, 24, 32, 48, 64};
+#define N_LIMITES_PDQ ((int)(sizeof(limites_pdq) / sizeof(limites_pdq[0])))
+
+enum {
+    ALG_QSORT_LIBC,
+    ALG_PDQSORT,
+    ALG_MERGESORT,
+    ALG_MERGESORT_PARALELO,
+    ALG_ADAPTATIVO,
+    ALG_INSERTION,
+    N_ALGORITMOS
+};
+
+static const char* nomes_algoritmos[] = {
+    "qsort(libc)", "pdqsort", "mergesort", "mergesort_par", "adaptativo", "insertion"
+};
+
+static double agora_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+// Gera a chave do i-ésimo elemento segundo a distribuição
+static double gera_chave(int distribuicao, int i, int n) {
+    switch (distribuicao) {
+        case 0: return (double)(rand() % (n * 4));
+        case 1: return (double)i;
+        case 2: return (double)(n - i);
+        default: return (double)(rand() % 16);
+    }
+}
+
+static void preenche(void* array, int n, const TipoElemento* tipo, int distribuicao) {
+    for (int i = 0; i < n; i++) {
+        double chave = gera_chave(distribuicao, i, n);
+        char* elem = (char*)array + (size_t)i * tipo->tam;
+        if (tipo->compara == compara_int) {
+            *(int*)elem = (int)chave;
+        } else if (tipo->compara == compara_double) {
+            *(double*)elem = chave;
+        } else {
+            Registro r = {chave, (double)i, -(double)i};
+            memcpy(elem, &r, sizeof(Registro));
+        }
+    }
+}
+
+static int esta_ordenado(const void* array, int n, const TipoElemento* tipo) {
+    for (int i = 1; i < n; i++) {
+        const char* a = (const char*)array + (size_t)(i - 1) * tipo->tam;
+        if (tipo->compara(a, a + tipo->tam) > 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void executa(int algoritmo, int limite, void* array, int n, const TipoElemento* tipo, void* buffer) {
+    switch (algoritmo) {
+        case ALG_QSORT_LIBC:
+            qsort(array, n, tipo->tam, tipo->compara);
+            break;
+        case ALG_PDQSORT:
+            ordena_pdqsort_com_limite(array, n, tipo->tam, limite, tipo->compara);
+            break;
+        case ALG_MERGESORT:
+            ordena_mergesort_com_buffer(array, n, tipo->tam, limite, tipo->compara, buffer);
+            break;
+        case ALG_MERGESORT_PARALELO:
+            ordena_mergesort_paralelo(array, n, tipo->tam, limite, tipo->compara, 4);
+            break;
+        case ALG_ADAPTATIVO:
+            ordena_adaptativo(array, n, tipo->tam, tipo->compara);
+            break;
+        default:
+            ordena_insertion_sort(array, 0, n - 1, tipo->tam, tipo->compara);
+            break;
+    }
+}
+
+/*
+* Mede o tempo médio por elemento (ns) de um algoritmo.
+* 'original' guarda a entrada; cada repetição a copia para 'array' antes de ordenar,
+* e só o tempo da ordenação é contado. Retorna um valor negativo se o resultado estiver errado.
+*/
+static double mede(int algoritmo, int limite, const void* original, void* array, void* buffer, int n, const TipoElemento* tipo) {
+    int repeticoes = ELEMENTOS_POR_MEDICAO / n;
+    if (repeticoes < 1) repeticoes = 1;
+    
+    double total = 0;
+    for (int r = 0; r < repeticoes; r++) {
+        memcpy(array, original, (size_t)n * tipo->tam);
+        double inicio = agora_ns();
+        executa(algoritmo, limite, array, n, tipo, buffer);
+        total += agora_ns() - inicio;
+    }
+    
+    if (!esta_ordenado(array, n, tipo)) {
+        return -1;
+    }
+    return total / ((double)repeticoes * n);
+}
+
+/*
+* Mede cada limite candidato em todos os tipos e distribuições; retorna o de menor custo
+* relativo somado. Um candidato que ordena errado fica com custo infinito (nunca é escolhido)
+* e soma 1 em 'erros'.
+*/
+static int calibra(int algoritmo, const int* candidatos, int n_candidatos, void* original, void* array, void* buffer,
+                   int* erros) {
+    double custo[64] = {0};
+    
+    for (int t = 0; t < N_TIPOS; t++) {
+        for (int d = 0; d < N_DISTRIBUICOES; d++) {
+            srand(1000 + d);
+            preenche(original, N_CALIBRACAO, &tipos[t], d);
+            
+            double tempos[64];
+            double melhor = -1;
+            for (int c = 0; c < n_candidatos; c++) {
+                tempos[c] = mede(algoritmo, candidatos[c], original, array, buffer, N_CALIBRACAO, &tipos[t]);
+                if (tempos[c] >= 0 && (melhor < 0 || tempos[c] < melhor)) melhor = tempos[c];
+            }
+            
+            // Custo relativo ao melhor candidato do caso: cada caso pesa o mesmo
+            for (int c = 0; c < n_candidatos; c++) {
+                if (tempos[c] < 0) {
+                    if (custo[c] != INFINITY) (*erros)++;
+                    custo[c] = INFINITY;
+                } else {
+                    custo[c] += melhor > 0 ? tempos[c] / melhor : 1.0;
+                }
+            }
+        }
+    }
+    
+    int escolhido = 0;
+    printf("  %-10s", "limite");
+    for (int c = 0; c < n_candidatos; c++) printf(" %6d", candidatos[c]);
+    printf("\n  %-10s", "custo");
+    for (int c = 0; c < n_candidatos; c++) {
+        if (custo[c] == INFINITY) printf(" %6s", "ERRO");
+        else printf(" %6.2f", custo[c] / (N_TIPOS * N_DISTRIBUICOES));
+        if (custo[c] < custo[escolhido]) escolhido = c;
+    }
+    printf("\n");
+    
+    return candidatos[escolhido];
+}
+
+static int grava_header(const char* caminho, int limite_mergesort, int limite_pdq) {
+    FILE* f = fopen(caminho, "w");
+    if (f == NULL) {
+        printf("Erro ao criar o arquivo %s\n", caminho);
+        return 0;
+    }
+    
+    fprintf(f, "#ifndef ORDENACAO_TUNED_H\n");
+    fprintf(f, "#define ORDENACAO_TUNED_H\n\n");
+    fprintf(f, "/*\n");
+    fprintf(f, "* Gerado por 'make bench-sort' (bench/bench_ordenacao.c). Não editar.\n");
+    fprintf(f, "* Limites do Insertion Sort medidos nesta máquina; apague o arquivo e rode make clean para voltar aos padrões.\n");
+    fprintf(f, "*/\n\n");
+    fprintf(f, "#define ORDENACAO_LIMITE_MERGESORT %d\n", limite_mergesort);
+    fprintf(f, "#define ORDENACAO_LIMITE_PDQ %d\n\n", limite_pdq);
+    fprintf(f, "#endif\n");
+    
+    fclose(f);
+    return 1;
+}
+
+int main(int argc, char* argv[]) {
+    const char* saida = argc > 1 ? argv[1] : NULL;
+    int n_max = tamanhos[N_TAMANHOS - 1];
+    
+    // Espaço para o maior elemento; o buffer do mergesort precisa de n + 1
+    size_t bytes = (size_t)(n_max + 1) * sizeof(Registro);
+    void* original = malloc(bytes);
+    void* array = malloc(bytes);
+    void* buffer = malloc(bytes);
+    if (original == NULL || array == NULL || buffer == NULL) {
+        printf("Erro ao alocar memória para o benchmark\n");
+        free(original);
+        free(array);
+        free(buffer);
+        return 1;
+    }
+    
+    int erros = 0;
+    
+    printf("ns/elemento (limites atuais: mergesort=%d, pdqsort=%d)\n",
+           ORDENACAO_LIMITE_MERGESORT, ORDENACAO_LIMITE_PDQ);
+    printf("%-9s %-14s %7s", "tipo", "distribuicao", "n");
+    for (int a = 0; a < N_ALGORITMOS; a++) printf(" %13s", nomes_algoritmos[a]);
+    printf("\n");
+    
+    for (int t = 0; t < N_TIPOS; t++) {
+        for (int d = 0; d < N_DISTRIBUICOES; d++) {
+            for (int s = 0; s < N_TAMANHOS; s++) {
+                int n = tamanhos[s];
+                srand(d * 31 + s);
+                preenche(original, n, &tipos[t], d);
+                
+                printf("%-9s %-14s %7d", tipos[t].nome, distribuicoes[d], n);
+                for (int a = 0; a < N_ALGORITMOS; a++) {
+                    if (a == ALG_INSERTION && n > N_MAX_INSERCAO) {
+                        printf(" %13s", "-");
+                        continue;
+                    }
+                    double ns = mede(a, 0, original, array, buffer, n, &tipos[t]);
+                    if (ns < 0) {
+                        printf(" %13s", "ERRO");
+                        erros++;
+                    } else {
+                        printf(" %13.2f", ns);
+                    }
+                }
+                printf("\n");
+                fflush(stdout);
+            }
+        }
+    }
+    
+    printf("\nCalibrando o limite do mergesort (n=%d)\n", N_CALIBRACAO);
+    int limite_mergesort = calibra(ALG_MERGESORT, limites_mergesort, N_LIMITES_MERGESORT, original, array, buffer, &erros);
+    printf("Calibrando o limite do pdqsort (n=%d)\n", N_CALIBRACAO);
+    int limite_pdq = calibra(ALG_PDQSORT, limites_pdq, N_LIMITES_PDQ, original, array, buffer, &erros);
+    
+    printf("\nMelhores limites: mergesort=%d, pdqsort=%d\n", limite_mergesort, limite_pdq);
+    
+    // Com qualquer ordenação errada o header não é gerado (e o make falha)
+    if (saida != NULL && erros == 0) {
+        if (grava_header(saida, limite_mergesort, limite_pdq)) {
+            printf("Limites gravados em %s (usados no próximo build)\n", saida);
+        }
+    }
+    
+    free(original);
+    free(array);
+    free(buffer);
+    
+    if (erros > 0) {
+        printf("Erro: %d ordenações incorretas\n", erros);
+        return 1;
+    }
+    return 0;
+}
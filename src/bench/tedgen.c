@@ -0,0 +1,374 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+/*
+* Gerador de cenas (.geo) e consultas (.qry) sintéticas para testes de desempenho.
+* A saída depende só dos parâmetros e da semente: o gerador pseudoaleatório é próprio
+* (não usa rand(), que varia entre bibliotecas C) e os números são gravados com duas
+* casas, então a mesma linha de comando gera os mesmos arquivos em qualquer máquina.
+*
+* Uso: tedgen -o <base> [opções]   (compilado por 'make tedgen')
+* Grava <base>.geo e, se houver comandos, <base>.qry.
+*/
+
+// Área da cena (a visibilidade usa a caixa -100..1100 x -100..800).
+#define LARGURA_PADRAO 1000.0
+#define ALTURA_PADRAO 700.0
+// Raio em volta da bomba anterior em que caem as bombas "locais".
+#define RAIO_LOCAL_PADRAO 50.0
+
+typedef struct {
+    const char* base;
+    uint64_t semente;
+    int formas;
+    double largura, altura;
+    double densidade;          // Fração da área (centrada) onde as formas ficam
+    double pesos_formas[4];    // c r l t
+    int texto_min, texto_max;
+    int mudancas_ts;           // Comandos ts espalhados pelo .geo
+    int anteparos_iniciais;    // Comandos 'a' no começo do .qry
+    int comandos;              // Comandos sorteados depois deles
+    double pesos_comandos[4];  // a d p cln
+    double localidade;         // Probabilidade de a bomba cair perto da anterior
+    double raio_local;
+} Parametros;
+
+/*==========================*/
+/* Gerador pseudoaleatório  */
+/*==========================*/
+
+// splitmix64: rápido, de estado pequeno e com saída idêntica em qualquer plataforma.
+static uint64_t estado_gerador;
+
+static uint64_t proximo(void) {
+    uint64_t z = (estado_gerador += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// Uniforme em [0, 1).
+static double uniforme(void) {
+    return (double)(proximo() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static double entre(double a, double b) {
+    return a + (b - a) * uniforme();
+}
+
+// Inteiro uniforme em [a, b].
+static int inteiro(int a, int b) {
+    return a + (int)(proximo() % (uint64_t)(b - a + 1));
+}
+
+// Índice sorteado com probabilidade proporcional ao peso.
+static int escolhe(const double* pesos, int n) {
+    double total = 0;
+    for (int i = 0; i < n; i++) total += pesos[i];
+    double r = uniforme() * total;
+    for (int i = 0; i < n - 1; i++) {
+        if (r < pesos[i]) return i;
+        r -= pesos[i];
+    }
+    return n - 1;
+}
+
+/*==========================*/
+/* Geração do .geo          */
+/*==========================*/
+
+static const char* cores_base[] = {
+    "#000000", "#ff0000", "#00ff00", "#0000ff", "#ffff00", "#00ffff", "#ff00ff",
+    "#123456", "#aa0000", "#00aa00", "#cccccc", "#ffffff"
+};
+#define N_CORES_BASE ((int)(sizeof(cores_base) / sizeof(cores_base[0])))
+
+static const char* familias[] = {"sans", "serif", "cursive"};
+static const char* pesos_fonte[] = {"n", "b", "b+", "l"};
+static const char ancoras[] = {'i', 'm', 'f'};
+
+// Metade das cores vem de uma paleta pequena e a outra é um hexadecimal qualquer.
+static void sorteia_cor(char* cor) {
+    if (uniforme() < 0.5) {
+        strcpy(cor, cores_base[inteiro(0, N_CORES_BASE - 1)]);
+    } else {
+        sprintf(cor, "#%06x", (unsigned) (proximo() & 0xFFFFFF));
+    }
+}
+
+static void sorteia_texto(char* texto, int min, int max) {
+    static const char letras[] = "abcdefghijklmnopqrstuvwxyz";
+    int n = inteiro(min, max);
+    for (int i = 0; i < n; i++) {
+        // Espaço de vez em quando, nunca no começo nem no fim
+        texto[i] = (i > 0 && i < n - 1 && uniforme() < 0.15) ? ' ' : letras[inteiro(0, 25)];
+    }
+    texto[n] = '\0';
+}
+
+static void ponto_na_cena(const Parametros* p, double* x, double* y) {
+    double lado = p->densidade < 1.0 ? p->densidade : 1.0;
+    double mx = p->largura * (1.0 - lado) / 2, my = p->altura * (1.0 - lado) / 2;
+    *x = entre(mx, p->largura - mx);
+    *y = entre(my, p->altura - my);
+}
+
+static int compara_int(const void* a, const void* b) {
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+static void escreve_ts(FILE* arq) {
+    fprintf(arq, "ts %s %s %d\n", familias[inteiro(0, 2)], pesos_fonte[inteiro(0, 3)], inteiro(8, 20));
+}
+
+static int gera_geo(const Parametros* p, const char* caminho) {
+    FILE* arq = fopen(caminho, "w");
+    char* texto = (char*) malloc((size_t) p->texto_max + 1);
+    // Os ts entram antes das formas de posições sorteadas (a posição 'formas' é o fim)
+    int* posicoes_ts = (int*) malloc((size_t) (p->mudancas_ts + 1) * sizeof(int));
+    if (arq == NULL || texto == NULL || posicoes_ts == NULL) {
+        printf("Erro ao criar %s\n", caminho);
+        if (arq != NULL) fclose(arq);
+        free(texto);
+        free(posicoes_ts);
+        return 0;
+    }
+    for (int k = 0; k < p->mudancas_ts; k++) {
+        posicoes_ts[k] = inteiro(0, p->formas);
+    }
+    qsort(posicoes_ts, (size_t) p->mudancas_ts, sizeof(int), compara_int);
+    int ts_feitos = 0;
+
+    char corb[16], corp[16];
+    for (int id = 1; id <= p->formas; id++) {
+        while (ts_feitos < p->mudancas_ts && posicoes_ts[ts_feitos] < id) {
+            escreve_ts(arq);
+            ts_feitos++;
+        }
+
+        double x, y;
+        ponto_na_cena(p, &x, &y);
+        sorteia_cor(corb);
+        sorteia_cor(corp);
+
+        switch (escolhe(p->pesos_formas, 4)) {
+            case 0:
+                fprintf(arq, "c %d %.2f %.2f %.2f %s %s\n", id, x, y, entre(2, 30), corb, corp);
+                break;
+            case 1:
+                fprintf(arq, "r %d %.2f %.2f %.2f %.2f %s %s\n", id, x, y, entre(5, 80), entre(5, 80),
+                        corb, corp);
+                break;
+            case 2:
+                fprintf(arq, "l %d %.2f %.2f %.2f %.2f %s\n", id, x, y,
+                        x + entre(-100, 100), y + entre(-100, 100), corb);
+                break;
+            default:
+                sorteia_texto(texto, p->texto_min, p->texto_max);
+                fprintf(arq, "t %d %.2f %.2f %s %s %c %s\n", id, x, y, corb, corp,
+                        ancoras[inteiro(0, 2)], texto);
+                break;
+        }
+    }
+
+    while (ts_feitos < p->mudancas_ts) {
+        escreve_ts(arq);
+        ts_feitos++;
+    }
+
+    free(texto);
+    free(posicoes_ts);
+    int ok = !ferror(arq);
+    if (fclose(arq) != 0) ok = 0;
+    return ok;
+}
+
+/*==========================*/
+/* Geração do .qry          */
+/*==========================*/
+
+// 'a' sobre um intervalo de até 10 ids sorteado.
+static void escreve_anteparo(FILE* arq, const Parametros* p) {
+    int id_min = inteiro(1, p->formas > 0 ? p->formas : 1);
+    fprintf(arq, "a %d %d %c\n", id_min, id_min + inteiro(0, 9), uniforme() < 0.5 ? 'h' : 'v');
+}
+
+static int gera_qry(const Parametros* p, const char* caminho) {
+    FILE* arq = fopen(caminho, "w");
+    if (arq == NULL) {
+        printf("Erro ao criar %s\n", caminho);
+        return 0;
+    }
+
+    // Sem anteparos a região de uma bomba é a caixa inteira: os 'a' iniciais dão
+    // às bombas seguintes regiões de verdade
+    for (int i = 0; i < p->anteparos_iniciais; i++) {
+        escreve_anteparo(arq, p);
+    }
+
+    // A primeira bomba (e as não locais) caem em qualquer lugar da caixa da visibilidade
+    double bx = entre(-50, p->largura + 50), by = entre(-50, p->altura + 50);
+    char cor[16];
+
+    for (int i = 0; i < p->comandos; i++) {
+        int tipo = escolhe(p->pesos_comandos, 4);
+        if (tipo == 0) {
+            escreve_anteparo(arq, p);
+            continue;
+        }
+
+        if (i > 0 && uniforme() < p->localidade) {
+            bx += entre(-p->raio_local, p->raio_local);
+            by += entre(-p->raio_local, p->raio_local);
+        } else {
+            bx = entre(-50, p->largura + 50);
+            by = entre(-50, p->altura + 50);
+        }
+
+        switch (tipo) {
+            case 1:
+                fprintf(arq, "d %.2f %.2f -\n", bx, by);
+                break;
+            case 2:
+                sorteia_cor(cor);
+                fprintf(arq, "p %.2f %.2f %s -\n", bx, by, cor);
+                break;
+            default:
+                fprintf(arq, "cln %.2f %.2f %.2f %.2f -\n", bx, by, entre(-20, 20), entre(-20, 20));
+                break;
+        }
+    }
+
+    int ok = !ferror(arq);
+    if (fclose(arq) != 0) ok = 0;
+    return ok;
+}
+
+/*==========================*/
+/* Linha de comando         */
+/*==========================*/
+
+static void uso(void) {
+    printf("Uso: tedgen -o <base> [opções]\n"
+           "  --semente N          semente do gerador (padrão 1)\n"
+           "  --formas N           número de formas no .geo (padrão 1000)\n"
+           "  --area L A           largura e altura da cena (padrão 1000 700)\n"
+           "  --densidade D        fração (0..1] de cada eixo, centrada, onde ficam as formas (padrão 1)\n"
+           "  --tipos C R L T      pesos de círculos, retângulos, linhas e textos (padrão 1 1 1 1)\n"
+           "  --texto MIN MAX      tamanho dos textos em caracteres (padrão 3 20)\n"
+           "  --ts N               comandos ts espalhados pelo .geo (padrão 0)\n"
+           "  --anteparos N        comandos 'a' no começo do .qry (padrão 10)\n"
+           "  --comandos N         comandos sorteados depois deles (padrão 100)\n"
+           "  --mix A D P CLN      pesos dos comandos a, d, p e cln (padrão 1 3 3 3)\n"
+           "  --localidade P       probabilidade (0..1) de a bomba cair perto da anterior (padrão 0)\n"
+           "  --raio-local R       distância máxima dessas bombas à anterior (padrão 50)\n");
+}
+
+// Lê 'n' números depois de argv[*i]; falha se faltarem.
+static int le_numeros(int argc, char* argv[], int* i, double* v, int n) {
+    if (*i + n >= argc) return 0;
+    for (int k = 0; k < n; k++) {
+        char* fim;
+        v[k] = strtod(argv[++*i], &fim);
+        if (*fim != '\0') return 0;
+    }
+    return 1;
+}
+
+int main(int argc, char* argv[]) {
+    Parametros p = {
+        .base = NULL, .semente = 1, .formas = 1000,
+        .largura = LARGURA_PADRAO, .altura = ALTURA_PADRAO, .densidade = 1.0,
+        .pesos_formas = {1, 1, 1, 1}, .texto_min = 3, .texto_max = 20, .mudancas_ts = 0,
+        .anteparos_iniciais = 10, .comandos = 100, .pesos_comandos = {1, 3, 3, 3},
+        .localidade = 0.0, .raio_local = RAIO_LOCAL_PADRAO
+    };
+
+    for (int i = 1; i < argc; i++) {
+        double v[4];
+        int ok = 1;
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            p.base = argv[++i];
+        } else if (strcmp(argv[i], "--semente") == 0 && i + 1 < argc) {
+            char* fim;
+            p.semente = (uint64_t) strtoull(argv[++i], &fim, 10);
+            ok = *fim == '\0';
+        } else if (strcmp(argv[i], "--formas") == 0 && (ok = le_numeros(argc, argv, &i, v, 1))) {
+            p.formas = (int) v[0];
+        } else if (strcmp(argv[i], "--area") == 0 && (ok = le_numeros(argc, argv, &i, v, 2))) {
+            p.largura = v[0];
+            p.altura = v[1];
+        } else if (strcmp(argv[i], "--densidade") == 0 && (ok = le_numeros(argc, argv, &i, v, 1))) {
+            p.densidade = v[0];
+        } else if (strcmp(argv[i], "--tipos") == 0 && (ok = le_numeros(argc, argv, &i, v, 4))) {
+            memcpy(p.pesos_formas, v, sizeof(v));
+        } else if (strcmp(argv[i], "--texto") == 0 && (ok = le_numeros(argc, argv, &i, v, 2))) {
+            p.texto_min = (int) v[0];
+            p.texto_max = (int) v[1];
+        } else if (strcmp(argv[i], "--ts") == 0 && (ok = le_numeros(argc, argv, &i, v, 1))) {
+            p.mudancas_ts = (int) v[0];
+        } else if (strcmp(argv[i], "--anteparos") == 0 && (ok = le_numeros(argc, argv, &i, v, 1))) {
+            p.anteparos_iniciais = (int) v[0];
+        } else if (strcmp(argv[i], "--comandos") == 0 && (ok = le_numeros(argc, argv, &i, v, 1))) {
+            p.comandos = (int) v[0];
+        } else if (strcmp(argv[i], "--mix") == 0 && (ok = le_numeros(argc, argv, &i, v, 4))) {
+            memcpy(p.pesos_comandos, v, sizeof(v));
+        } else if (strcmp(argv[i], "--localidade") == 0 && (ok = le_numeros(argc, argv, &i, v, 1))) {
+            p.localidade = v[0];
+        } else if (strcmp(argv[i], "--raio-local") == 0 && (ok = le_numeros(argc, argv, &i, v, 1))) {
+            p.raio_local = v[0];
+        } else {
+            printf("Erro: opção inválida ou incompleta: %s\n", argv[i]);
+            uso();
+            return 1;
+        }
+        if (!ok) {
+            printf("Erro: valores inválidos para %s\n", argv[i]);
+            uso();
+            return 1;
+        }
+    }
+
+    double soma_formas = 0, soma_comandos = 0;
+    for (int k = 0; k < 4; k++) {
+        if (p.pesos_formas[k] < 0 || p.pesos_comandos[k] < 0) p.base = NULL;
+        soma_formas += p.pesos_formas[k];
+        soma_comandos += p.pesos_comandos[k];
+    }
+    if (p.base == NULL || p.formas < 0 || p.comandos < 0 || p.anteparos_iniciais < 0 || p.mudancas_ts < 0 ||
+        p.largura <= 0 || p.altura <= 0 || p.densidade <= 0 ||
+        p.texto_min < 1 || p.texto_max < p.texto_min ||
+        soma_formas <= 0 || soma_comandos <= 0 || p.localidade < 0 || p.localidade > 1) {
+        printf("Erro: parâmetros inválidos\n");
+        uso();
+        return 1;
+    }
+
+    estado_gerador = p.semente;
+
+    size_t len = strlen(p.base) + 5;
+    char* caminho = (char*) malloc(len);
+    if (caminho == NULL) {
+        printf("Erro ao alocar caminho\n");
+        return 1;
+    }
+
+    snprintf(caminho, len, "%s.geo", p.base);
+    int ok = gera_geo(&p, caminho);
+    if (ok) printf("Cena gravada em %s (%d formas)\n", caminho, p.formas);
+
+    if (ok && p.anteparos_iniciais + p.comandos > 0) {
+        snprintf(caminho, len, "%s.qry", p.base);
+        ok = gera_qry(&p, caminho);
+        if (ok) printf("Consulta gravada em %s (%d comandos)\n", caminho, p.anteparos_iniciais + p.comandos);
+    }
+    if (!ok) {
+        printf("Erro ao gravar os arquivos\n");
+    }
+
+    free(caminho);
+    return ok ? 0 : 1;
+}
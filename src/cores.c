@@ -0,0 +1,265 @@
+#include "cores.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+// As entradas ficam em blocos que nunca mudam de lugar: ler um id não precisa de trava.
+#define BITS_BLOCO_COR 10
+#define TAM_BLOCO_COR (1 << BITS_BLOCO_COR)
+#define MAX_BLOCOS_COR 4096
+// Capacidade inicial do índice de busca (potência de 2).
+#define CAPACIDADE_INICIAL_COR 256
+// Posições do cache de cada thread de leitura (potência de 2).
+#define TAM_CACHE_COR 64
+
+typedef struct {
+    char* texto;
+    uint32_t hash;
+    uint32_t rgba;
+    int eh_hex;
+} EntradaCor;
+
+/*
+* Tabela: entradas por id em blocos e um índice com endereçamento aberto
+* (hash -> id + 1; 0 marca posição vazia).
+*/
+typedef struct {
+    EntradaCor* blocos[MAX_BLOCOS_COR];
+    int quantidade;          // Inclui a entrada COR_NENHUMA
+    int* indice;
+    int capacidade;
+} EstruturaCores;
+
+static EstruturaCores tabela;
+static pthread_mutex_t trava_cores = PTHREAD_MUTEX_INITIALIZER;
+
+/*
+* Cache de uma thread: posição pelo hash, guardando o id da última cor vista ali.
+* Uma entrada nunca muda depois de cadastrada, então conferir o texto dispensa a trava.
+*/
+typedef struct {
+    uint32_t hash[TAM_CACHE_COR];
+    IdCor id[TAM_CACHE_COR];
+} CacheCores;
+
+static pthread_key_t chave_cache;
+static pthread_once_t chave_cache_criada = PTHREAD_ONCE_INIT;
+
+static void cria_chave_cache(void) {
+    pthread_key_create(&chave_cache, NULL);
+}
+
+static CacheCores* cache_da_thread(void) {
+    pthread_once(&chave_cache_criada, cria_chave_cache);
+    return (CacheCores*) pthread_getspecific(chave_cache);
+}
+
+static uint32_t hash_texto(const char* s) {
+    uint32_t h = 2166136261u;
+    for (; *s != '\0'; s++) {
+        h = (h ^ (unsigned char) *s) * 16777619u;
+    }
+    return h;
+}
+
+static EntradaCor* entrada(IdCor cor) {
+    return &tabela.blocos[cor >> BITS_BLOCO_COR][cor & (TAM_BLOCO_COR - 1)];
+}
+
+static int valor_hex(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+/*
+* Converte "#rgb", "#rrggbb" ou "#rrggbbaa" em 0xRRGGBBAA.
+*/
+static int converte_hex(const char* s, uint32_t* rgba) {
+    if (s[0] != '#') return 0;
+    size_t n = strlen(s + 1);
+    if (n != 3 && n != 6 && n != 8) return 0;
+
+    uint32_t v = 0;
+    for (size_t i = 1; i <= n; i++) {
+        int d = valor_hex(s[i]);
+        if (d < 0) return 0;
+        v = (v << 4) | (uint32_t) d;
+        if (n == 3) v = (v << 4) | (uint32_t) d;   // "#abc" equivale a "#aabbcc"
+    }
+    if (n != 8) v = (v << 8) | 0xFF;
+    *rgba = v;
+    return 1;
+}
+
+static int inicializa(void) {
+    tabela.indice = (int*) calloc(CAPACIDADE_INICIAL_COR, sizeof(int));
+    tabela.blocos[0] = (EntradaCor*) calloc(TAM_BLOCO_COR, sizeof(EntradaCor));
+    if (tabela.indice == NULL || tabela.blocos[0] == NULL) {
+        free(tabela.indice);
+        free(tabela.blocos[0]);
+        tabela.indice = NULL;
+        tabela.blocos[0] = NULL;
+        return 0;
+    }
+    tabela.capacidade = CAPACIDADE_INICIAL_COR;
+    tabela.quantidade = 1;   // COR_NENHUMA: entrada zerada, texto NULL
+    return 1;
+}
+
+static int expande_indice(void) {
+    int nova_capacidade = tabela.capacidade * 2;
+    int* novo = (int*) calloc((size_t) nova_capacidade, sizeof(int));
+    if (novo == NULL) return 0;
+
+    for (int i = 0; i < tabela.capacidade; i++) {
+        int v = tabela.indice[i];
+        if (v == 0) continue;
+        uint32_t pos = entrada(v - 1)->hash & (uint32_t)(nova_capacidade - 1);
+        while (novo[pos] != 0) pos = (pos + 1) & (uint32_t)(nova_capacidade - 1);
+        novo[pos] = v;
+    }
+    free(tabela.indice);
+    tabela.indice = novo;
+    tabela.capacidade = nova_capacidade;
+    return 1;
+}
+
+static IdCor interna_com_trava(const char* texto, uint32_t h) {
+    IdCor resultado = COR_NENHUMA;
+
+    pthread_mutex_lock(&trava_cores);
+    if (tabela.indice == NULL && !inicializa()) {
+        printf("Erro ao alocar a tabela de cores\n");
+        pthread_mutex_unlock(&trava_cores);
+        return COR_NENHUMA;
+    }
+
+    uint32_t mascara = (uint32_t)(tabela.capacidade - 1);
+    uint32_t pos = h & mascara;
+    while (tabela.indice[pos] != 0) {
+        EntradaCor* e = entrada(tabela.indice[pos] - 1);
+        if (e->hash == h && strcmp(e->texto, texto) == 0) {
+            resultado = tabela.indice[pos] - 1;
+            pthread_mutex_unlock(&trava_cores);
+            return resultado;
+        }
+        pos = (pos + 1) & mascara;
+    }
+
+    // Cor nova: cadastra no próximo id
+    IdCor id = tabela.quantidade;
+    int bloco = id >> BITS_BLOCO_COR;
+    if (bloco >= MAX_BLOCOS_COR) {
+        printf("Erro: limite de cores distintas atingido\n");
+        pthread_mutex_unlock(&trava_cores);
+        return COR_NENHUMA;
+    }
+    if (tabela.blocos[bloco] == NULL) {
+        tabela.blocos[bloco] = (EntradaCor*) calloc(TAM_BLOCO_COR, sizeof(EntradaCor));
+    }
+    size_t len = strlen(texto) + 1;
+    char* copia = (char*) malloc(len);
+    if (tabela.blocos[bloco] == NULL || copia == NULL) {
+        printf("Erro ao alocar cor em cores_interna\n");
+        free(copia);
+        pthread_mutex_unlock(&trava_cores);
+        return COR_NENHUMA;
+    }
+    memcpy(copia, texto, len);
+
+    EntradaCor* e = entrada(id);
+    e->texto = copia;
+    e->hash = h;
+    e->eh_hex = converte_hex(copia, &e->rgba);
+    tabela.indice[pos] = id + 1;
+    tabela.quantidade++;
+    resultado = id;
+
+    // Mantém o índice no máximo meio cheio
+    if (2 * tabela.quantidade > tabela.capacidade && !expande_indice()) {
+        printf("Erro ao expandir a tabela de cores\n");
+    }
+
+    pthread_mutex_unlock(&trava_cores);
+    return resultado;
+}
+
+IdCor cores_interna(const char* texto) {
+    if (texto == NULL) return COR_NENHUMA;
+
+    uint32_t h = hash_texto(texto);
+    CacheCores* cache = cache_da_thread();
+    if (cache == NULL) {
+        return interna_com_trava(texto, h);
+    }
+
+    uint32_t pos = h & (TAM_CACHE_COR - 1);
+    IdCor id = cache->id[pos];
+    if (id != COR_NENHUMA && cache->hash[pos] == h && strcmp(entrada(id)->texto, texto) == 0) {
+        return id;
+    }
+    id = interna_com_trava(texto, h);
+    cache->hash[pos] = h;
+    cache->id[pos] = id;
+    return id;
+}
+
+void cores_inicia_cache(void) {
+    if (cache_da_thread() != NULL) return;
+
+    CacheCores* cache = (CacheCores*) calloc(1, sizeof(CacheCores));
+    if (cache == NULL || pthread_setspecific(chave_cache, cache) != 0) {
+        // Sem cache cores_interna continua correta, só passa sempre pela trava
+        free(cache);
+    }
+}
+
+void cores_encerra_cache(void) {
+    CacheCores* cache = cache_da_thread();
+    if (cache != NULL) {
+        pthread_setspecific(chave_cache, NULL);
+        free(cache);
+    }
+}
+
+const char* cores_texto(IdCor cor) {
+    if (cor <= COR_NENHUMA || cor >= MAX_BLOCOS_COR * TAM_BLOCO_COR ||
+        tabela.blocos[cor >> BITS_BLOCO_COR] == NULL) {
+        return NULL;
+    }
+    return entrada(cor)->texto;
+}
+
+int cores_rgba(IdCor cor, uint32_t* rgba) {
+    if (cores_texto(cor) == NULL) return 0;
+    EntradaCor* e = entrada(cor);
+    if (!e->eh_hex) return 0;
+    if (rgba) *rgba = e->rgba;
+    return 1;
+}
+
+int cores_quantidade(void) {
+    pthread_mutex_lock(&trava_cores);
+    int n = tabela.quantidade > 0 ? tabela.quantidade - 1 : 0;
+    pthread_mutex_unlock(&trava_cores);
+    return n;
+}
+
+void cores_libera(void) {
+    pthread_mutex_lock(&trava_cores);
+    for (int b = 0; b < MAX_BLOCOS_COR && tabela.blocos[b] != NULL; b++) {
+        for (int i = 0; i < TAM_BLOCO_COR; i++) {
+            free(tabela.blocos[b][i].texto);
+        }
+        free(tabela.blocos[b]);
+        tabela.blocos[b] = NULL;
+    }
+    free(tabela.indice);
+    tabela.indice = NULL;
+    tabela.capacidade = 0;
+    tabela.quantidade = 0;
+    pthread_mutex_unlock(&trava_cores);
+}
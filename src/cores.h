@@ -0,0 +1,67 @@
+#ifndef CORES_H
+#define CORES_H
+
+#include <stdint.h>
+
+/*
+* Tabela global de cores internadas.
+* Cada texto de cor distinto ("#FF0000", "blue", ...) é guardado uma única vez e
+* identificado por um inteiro pequeno; formas e anteparos guardam só esse id.
+* Trocar a cor de uma forma vira uma atribuição de inteiro, sem malloc/free.
+* A inserção é protegida por trava (a leitura do .geo cria formas em paralelo);
+* um id já obtido pode ser consultado de qualquer thread. As threads de leitura ligam
+* um cache próprio das cores já vistas, que resolve as repetidas sem a trava.
+*/
+
+typedef int IdCor;
+
+/*
+* Id reservado para "sem cor" (texto NULL).
+*/
+#define COR_NENHUMA 0
+
+/**
+ * @brief Retorna o id da cor, cadastrando o texto se ainda não existir.
+ * @param texto O texto da cor (NULL resulta em COR_NENHUMA).
+ * @return IdCor O id da cor, ou COR_NENHUMA em caso de erro.
+ */
+IdCor cores_interna(const char* texto);
+
+/**
+ * @brief Liga na thread atual o cache de cores consultado por cores_interna sem trava.
+ * Deve ser desligado pela mesma thread com cores_encerra_cache.
+ */
+void cores_inicia_cache(void);
+
+/**
+ * @brief Desliga e libera o cache de cores da thread atual.
+ */
+void cores_encerra_cache(void);
+
+/**
+ * @brief Retorna o texto original da cor.
+ * @param cor O id da cor.
+ * @return const char* O texto, ou NULL para COR_NENHUMA (ou id inválido).
+ */
+const char* cores_texto(IdCor cor);
+
+/**
+ * @brief Retorna a cor empacotada como 0xRRGGBBAA.
+ * Só cores hexadecimais ("#rgb", "#rrggbb" ou "#rrggbbaa") têm valor numérico.
+ * @param cor O id da cor.
+ * @param rgba Onde escrever o valor.
+ * @return int 1 se a cor é hexadecimal, 0 caso contrário.
+ */
+int cores_rgba(IdCor cor, uint32_t* rgba);
+
+/**
+ * @brief Retorna quantas cores distintas estão cadastradas.
+ */
+int cores_quantidade(void);
+
+/**
+ * @brief Libera a tabela. Os ids obtidos antes deixam de ser válidos.
+ */
+void cores_libera(void);
+
+#endif
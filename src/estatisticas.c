@@ -0,0 +1,170 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "estatisticas.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Capacidade inicial do array de registros.
+#define CAPACIDADE_INICIAL_REGISTROS 64
+
+typedef struct {
+    char comando[8];
+    int indice;
+    double tempo[NUM_FASES];
+    long long contador[NUM_CONTADORES];
+    int formas;
+} RegistroEstatistica;
+
+typedef struct {
+    RegistroEstatistica* registros;
+    int n, capacidade;
+    int aberto;              // Há um registro em andamento (o último)
+    double ultima_marca;
+} EstruturaEstatisticas;
+
+static const char* nomes_fases[NUM_FASES] = {
+    "leitura_s", "visibilidade_s", "sobreposicao_s", "mutacao_s", "saida_s"
+};
+
+static const char* nomes_contadores[NUM_CONTADORES] = {
+    "raios", "testes_raio_segmento", "vertices", "formas_testadas", "formas_atingidas", "alocacoes"
+};
+
+Estatisticas estatisticas_cria() {
+    EstruturaEstatisticas* e = (EstruturaEstatisticas*) calloc(1, sizeof(EstruturaEstatisticas));
+    if (e == NULL) {
+        printf("Erro ao alocar estatísticas\n");
+        return NULL;
+    }
+    return (Estatisticas) e;
+}
+
+void estatisticas_destroi(Estatisticas est) {
+    EstruturaEstatisticas* e = (EstruturaEstatisticas*) est;
+    if (e == NULL) return;
+    free(e->registros);
+    free(e);
+}
+
+double estatisticas_relogio(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec * 1e-9;
+}
+
+static RegistroEstatistica* registro_atual(EstruturaEstatisticas* e) {
+    return (e != NULL && e->aberto) ? &e->registros[e->n - 1] : NULL;
+}
+
+void estatisticas_abre_registro(Estatisticas est, const char* comando, int indice) {
+    EstruturaEstatisticas* e = (EstruturaEstatisticas*) est;
+    if (e == NULL) return;
+
+    if (e->n == e->capacidade) {
+        int nova = e->capacidade == 0 ? CAPACIDADE_INICIAL_REGISTROS : e->capacidade * 2;
+        RegistroEstatistica* novos = (RegistroEstatistica*) realloc(e->registros,
+                                                                    (size_t) nova * sizeof(RegistroEstatistica));
+        if (novos == NULL) {
+            printf("Erro ao expandir estatísticas\n");
+            e->aberto = 0;
+            return;
+        }
+        e->registros = novos;
+        e->capacidade = nova;
+    }
+
+    RegistroEstatistica* r = &e->registros[e->n++];
+    memset(r, 0, sizeof(RegistroEstatistica));
+    strncpy(r->comando, comando, sizeof(r->comando) - 1);
+    r->indice = indice;
+    e->aberto = 1;
+    e->ultima_marca = estatisticas_relogio();
+}
+
+void estatisticas_marca(Estatisticas est, FaseEstatistica fase) {
+    EstruturaEstatisticas* e = (EstruturaEstatisticas*) est;
+    RegistroEstatistica* r = registro_atual(e);
+    if (r == NULL) return;
+    double agora = estatisticas_relogio();
+    r->tempo[fase] += agora - e->ultima_marca;
+    e->ultima_marca = agora;
+}
+
+void estatisticas_soma_tempo(Estatisticas est, FaseEstatistica fase, double segundos) {
+    RegistroEstatistica* r = registro_atual((EstruturaEstatisticas*) est);
+    if (r != NULL) r->tempo[fase] += segundos;
+}
+
+void estatisticas_soma(Estatisticas est, ContadorEstatistica contador, long long n) {
+    RegistroEstatistica* r = registro_atual((EstruturaEstatisticas*) est);
+    if (r != NULL) r->contador[contador] += n;
+}
+
+void estatisticas_fecha_registro(Estatisticas est, int formas) {
+    EstruturaEstatisticas* e = (EstruturaEstatisticas*) est;
+    RegistroEstatistica* r = registro_atual(e);
+    if (r == NULL) return;
+    r->formas = formas;
+    e->aberto = 0;
+}
+
+static void grava_linha(FILE* arq, const RegistroEstatistica* r) {
+    double total = 0;
+    for (int f = 0; f < NUM_FASES; f++) {
+        total += r->tempo[f];
+    }
+    fprintf(arq, "%s,%d,%.6f", r->comando, r->indice, total);
+    for (int f = 0; f < NUM_FASES; f++) {
+        fprintf(arq, ",%.6f", r->tempo[f]);
+    }
+    for (int c = 0; c < NUM_CONTADORES; c++) {
+        fprintf(arq, ",%lld", r->contador[c]);
+    }
+    fprintf(arq, ",%d\n", r->formas);
+}
+
+int estatisticas_grava_csv(Estatisticas est, const char* caminho) {
+    EstruturaEstatisticas* e = (EstruturaEstatisticas*) est;
+    if (e == NULL) return 0;
+
+    FILE* arq = fopen(caminho, "w");
+    if (arq == NULL) {
+        printf("Erro ao criar arquivo de estatísticas: %s\n", caminho);
+        return 0;
+    }
+
+    fprintf(arq, "comando,indice,total_s");
+    for (int f = 0; f < NUM_FASES; f++) {
+        fprintf(arq, ",%s", nomes_fases[f]);
+    }
+    for (int c = 0; c < NUM_CONTADORES; c++) {
+        fprintf(arq, ",%s", nomes_contadores[c]);
+    }
+    fprintf(arq, ",formas\n");
+
+    RegistroEstatistica total;
+    memset(&total, 0, sizeof(total));
+    strcpy(total.comando, "total");
+    total.indice = -1;
+    for (int i = 0; i < e->n; i++) {
+        const RegistroEstatistica* r = &e->registros[i];
+        grava_linha(arq, r);
+        for (int f = 0; f < NUM_FASES; f++) {
+            total.tempo[f] += r->tempo[f];
+        }
+        for (int c = 0; c < NUM_CONTADORES; c++) {
+            total.contador[c] += r->contador[c];
+        }
+        total.formas = r->formas;
+    }
+    grava_linha(arq, &total);
+
+    int ok = !ferror(arq);
+    if (fclose(arq) != 0) ok = 0;
+    if (!ok) {
+        printf("Erro ao gravar arquivo de estatísticas: %s\n", caminho);
+    }
+    return ok;
+}
@@ -0,0 +1,86 @@
+#ifndef ESTATISTICAS_H
+#define ESTATISTICAS_H
+
+/*
+* Módulo de Estatísticas de Desempenho (--stats).
+* Guarda um registro por etapa da execução (a leitura do .geo e cada comando do .qry),
+* com o tempo de relógio separado por fase e contadores de trabalho, e grava tudo em
+* um CSV com uma linha de total no fim.
+*
+* Todas as funções aceitam uma Estatisticas NULL e não fazem nada: quem mede só chama
+* o relógio quando as estatísticas estão ligadas. Não é thread-safe: as threads de
+* cálculo medem em variáveis próprias e quem as criou soma os resultados.
+*/
+
+typedef void* Estatisticas;
+
+typedef enum {
+    FASE_LEITURA,            // Leitura do .geo/.geob
+    FASE_VISIBILIDADE,       // Cálculo da região (por bomba, mesmo quando o lote roda em paralelo)
+    FASE_SOBREPOSICAO,       // Seleção das formas atingidas
+    FASE_MUTACAO,            // Destruir, pintar, clonar, transformar em anteparo
+    FASE_SAIDA,              // Escrita no svg e no txt
+    NUM_FASES
+} FaseEstatistica;
+
+typedef enum {
+    CONT_RAIOS,              // Raios traçados pela visibilidade
+    CONT_TESTES_SEGMENTO,    // Testes exatos raio-anteparo (após o filtro por caixa)
+    CONT_VERTICES,           // Vértices das regiões de visibilidade
+    CONT_FORMAS_TESTADAS,    // Formas que passaram pelo teste detalhado de sobreposição
+    CONT_FORMAS_ATINGIDAS,   // Formas destruídas, pintadas, clonadas ou transformadas
+    CONT_ALOCACOES,          // Formas alocadas (na arena ou reaproveitadas)
+    NUM_CONTADORES
+} ContadorEstatistica;
+
+/**
+ * @brief Cria um conjunto de estatísticas vazio.
+ * @return Estatisticas As estatísticas, ou NULL em caso de erro.
+ */
+Estatisticas estatisticas_cria();
+
+/**
+ * @brief Libera as estatísticas.
+ */
+void estatisticas_destroi(Estatisticas e);
+
+/**
+ * @brief Retorna o tempo de um relógio monotônico, em segundos.
+ */
+double estatisticas_relogio(void);
+
+/**
+ * @brief Começa um novo registro e zera a marca de tempo.
+ * @param comando Nome da etapa ("geo", "a", "d", "p", "cln", ...).
+ * @param indice Posição do comando no .qry (-1 se não se aplica).
+ */
+void estatisticas_abre_registro(Estatisticas e, const char* comando, int indice);
+
+/**
+ * @brief Soma à fase o tempo desde a última marca e marca o instante atual.
+ */
+void estatisticas_marca(Estatisticas e, FaseEstatistica fase);
+
+/**
+ * @brief Soma um tempo medido à parte (em segundos) à fase do registro atual.
+ */
+void estatisticas_soma_tempo(Estatisticas e, FaseEstatistica fase, double segundos);
+
+/**
+ * @brief Soma 'n' ao contador do registro atual.
+ */
+void estatisticas_soma(Estatisticas e, ContadorEstatistica contador, long long n);
+
+/**
+ * @brief Fecha o registro atual.
+ * @param formas Número de formas na cena ao fim da etapa.
+ */
+void estatisticas_fecha_registro(Estatisticas e, int formas);
+
+/**
+ * @brief Grava os registros em CSV, com uma linha "total" no fim.
+ * @return int 1 em caso de sucesso, 0 em caso de erro.
+ */
+int estatisticas_grava_csv(Estatisticas e, const char* caminho);
+
+#endif
@@ -2,6 +2,10 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <pthread.h>
+
+// Baldes da tabela de estilos compartilhados (encadeamento).
+#define NUM_BALDES_ESTILO 256
 
 /*================================*/
 /* Estrutura Interna do TAD Estilo */
@@ -10,8 +14,21 @@ typedef struct estilo {
     char *fFamily; 
     char *fWeight;
     double fSize;
+    int referencias;         // Donos do estilo (textos, leitores); libera ao chegar em 0
+    int compartilhado;       // 1 se está na tabela de estilos_interna
+    unsigned hash;
+    struct estilo* proximo;  // Próximo no mesmo balde da tabela
+    struct estilo *vivo_ant, *vivo_prox;  // Lista de todos os estilos existentes
 } EstruturaEstilo;
 
+/*
+* Tabela dos estilos compartilhados. A trava também protege as contagens de
+* referência, já que textos de trechos lidos em paralelo dividem os mesmos estilos.
+*/
+static EstruturaEstilo* baldes_estilo[NUM_BALDES_ESTILO];
+static EstruturaEstilo* estilos_vivos = NULL;
+static pthread_mutex_t trava_estilos = PTHREAD_MUTEX_INITIALIZER;
+
 
 
 /**
@@ -38,7 +55,9 @@ static char* duplicar_string(const char* s) {
 /*=======================*/
 /* Constructor do Estilo */
 /*=======================*/
-Estilo estilo_cria(char* fFamily, char* fWeight, double fSize) {
+
+// Cria o estilo e o coloca na lista de vivos. Deve ser chamada com a trava.
+static EstruturaEstilo* cria_sem_trava(char* fFamily, char* fWeight, double fSize) {
     EstruturaEstilo *NovoEstilo = (EstruturaEstilo*) malloc(sizeof(EstruturaEstilo));
     if (NovoEstilo == NULL) {
         printf("Erro(0) em estilo_cria: falha na alocacao.\n");
@@ -62,8 +81,79 @@ Estilo estilo_cria(char* fFamily, char* fWeight, double fSize) {
     }
 
     NovoEstilo->fSize = fSize;
+    NovoEstilo->referencias = 1;
+    NovoEstilo->compartilhado = 0;
+    NovoEstilo->hash = 0;
+    NovoEstilo->proximo = NULL;
+
+    NovoEstilo->vivo_ant = NULL;
+    NovoEstilo->vivo_prox = estilos_vivos;
+    if (estilos_vivos != NULL) estilos_vivos->vivo_ant = NovoEstilo;
+    estilos_vivos = NovoEstilo;
+
+    return NovoEstilo;
+}
+
+Estilo estilo_cria(char* fFamily, char* fWeight, double fSize) {
+    pthread_mutex_lock(&trava_estilos);
+    EstruturaEstilo* novo = cria_sem_trava(fFamily, fWeight, fSize);
+    pthread_mutex_unlock(&trava_estilos);
+    return (Estilo) novo;
+}
+
+
+static unsigned hash_estilo(const char* fFamily, const char* fWeight, double fSize) {
+    unsigned h = 2166136261u;
+    for (const char* s = fFamily; *s != '\0'; s++) h = (h ^ (unsigned char) *s) * 16777619u;
+    h = (h ^ 0xFFu) * 16777619u;
+    for (const char* s = fWeight; *s != '\0'; s++) h = (h ^ (unsigned char) *s) * 16777619u;
+    const unsigned char* bytes = (const unsigned char*) &fSize;
+    for (size_t i = 0; i < sizeof(fSize); i++) h = (h ^ bytes[i]) * 16777619u;
+    return h;
+}
+
+Estilo estilo_interna(char* fFamily, char* fWeight, double fSize) {
+    if (fFamily == NULL || fWeight == NULL) {
+        fFamily = "sans-serif";
+        fWeight = "normal";
+    }
+    unsigned h = hash_estilo(fFamily, fWeight, fSize);
+    unsigned balde = h % NUM_BALDES_ESTILO;
+
+    pthread_mutex_lock(&trava_estilos);
+    for (EstruturaEstilo* e = baldes_estilo[balde]; e != NULL; e = e->proximo) {
+        if (e->hash == h && e->fSize == fSize &&
+            strcmp(e->fFamily, fFamily) == 0 && strcmp(e->fWeight, fWeight) == 0) {
+            e->referencias++;
+            pthread_mutex_unlock(&trava_estilos);
+            return (Estilo) e;
+        }
+    }
+
+    EstruturaEstilo* novo = cria_sem_trava(fFamily, fWeight, fSize);
+    if (novo != NULL) {
+        novo->compartilhado = 1;
+        novo->hash = h;
+        novo->proximo = baldes_estilo[balde];
+        baldes_estilo[balde] = novo;
+    }
+    pthread_mutex_unlock(&trava_estilos);
+    return (Estilo) novo;
+}
+
+Estilo estilo_referencia(Estilo e) {
+    if (e == NULL) return NULL;
+    pthread_mutex_lock(&trava_estilos);
+    ((EstruturaEstilo*) e)->referencias++;
+    pthread_mutex_unlock(&trava_estilos);
+    return e;
+}
 
-    return (Estilo) NovoEstilo;
+void estilo_acrescenta_referencias(Estilo e, int n) {
+    if (e == NULL || n <= 0) return;
+    pthread_mutex_lock(&trava_estilos);
+    ((EstruturaEstilo*) e)->referencias += n;
+    pthread_mutex_unlock(&trava_estilos);
 }
 
 
@@ -75,6 +165,21 @@ void estilo_destroi(Estilo e) {
 
     EstruturaEstilo *estilo = (EstruturaEstilo*) e;
 
+    pthread_mutex_lock(&trava_estilos);
+    if (--estilo->referencias > 0) {
+        pthread_mutex_unlock(&trava_estilos);
+        return;
+    }
+    if (estilo->compartilhado) {
+        EstruturaEstilo** p = &baldes_estilo[estilo->hash % NUM_BALDES_ESTILO];
+        while (*p != NULL && *p != estilo) p = &(*p)->proximo;
+        if (*p != NULL) *p = estilo->proximo;
+    }
+    if (estilo->vivo_ant != NULL) estilo->vivo_ant->vivo_prox = estilo->vivo_prox;
+    else estilos_vivos = estilo->vivo_prox;
+    if (estilo->vivo_prox != NULL) estilo->vivo_prox->vivo_ant = estilo->vivo_ant;
+    pthread_mutex_unlock(&trava_estilos);
+
     if (estilo->fFamily != NULL) {
         free(estilo->fFamily);
     }
@@ -85,6 +190,23 @@ void estilo_destroi(Estilo e) {
     free(estilo);
 }
 
+void estilo_libera_todos(void) {
+    pthread_mutex_lock(&trava_estilos);
+    EstruturaEstilo* e = estilos_vivos;
+    while (e != NULL) {
+        EstruturaEstilo* proximo = e->vivo_prox;
+        free(e->fFamily);
+        free(e->fWeight);
+        free(e);
+        e = proximo;
+    }
+    estilos_vivos = NULL;
+    for (int i = 0; i < NUM_BALDES_ESTILO; i++) {
+        baldes_estilo[i] = NULL;
+    }
+    pthread_mutex_unlock(&trava_estilos);
+}
+
 
 /*======================*/
 /*  Getters do Estilo   */
@@ -12,6 +12,11 @@
 * Caso haja um comando 'ts', todo texto criado a partir disso usará os parametros do comando 'ts'.
 * Textos clonados usam o mesmo estilo de sua forma original.
 *
+* Um estilo pode ter vários donos: milhares de textos costumam dividir poucos estilos.
+* estilo_interna devolve o estilo compartilhado de cada combinação (fonte, peso, tamanho)
+* e estilo_referencia acrescenta um dono; estilo_destroi solta uma referência e só libera
+* a memória quando a última é solta. Os setters alteram o estilo de todos os seus donos.
+*
 * Este arquivo contem todas as funções responsáveis pela manipulação de estilos de texto.
 */
 
@@ -32,17 +37,49 @@ typedef void* Estilo;
  */
 Estilo estilo_cria(char* fFamily, char* fWeight, double fSize);
 
+/**
+ * @brief Retorna o estilo compartilhado com esses parametros, criando-o na primeira vez.
+ * Quem chama recebe uma referência e deve soltá-la com estilo_destroi.
+ * Não altere um estilo compartilhado com os setters: a mudança valeria para todos.
+ * @param fFamily Familia do texto.
+ * @param fWeight 'Grossura' do texto.
+ * @param fSize Tamanho da fonte.
+ * @return Estilo O estilo compartilhado, ou NULL em caso de erro.
+ */
+Estilo estilo_interna(char* fFamily, char* fWeight, double fSize);
+
+/**
+ * @brief Acrescenta uma referência (um dono) ao estilo.
+ * @param e O estilo.
+ * @return Estilo O próprio estilo, para uso direto (ex: ao clonar um texto).
+ */
+Estilo estilo_referencia(Estilo e);
+
+/**
+ * @brief Acrescenta 'n' referências de uma vez (ex: os textos de um trecho do .geo).
+ * Quem as acumulou precisa manter a sua própria referência até acrescentá-las.
+ * @param e O estilo.
+ * @param n Número de referências (nada acontece se n <= 0).
+ */
+void estilo_acrescenta_referencias(Estilo e, int n);
+
 
 
 /*======================*/
 /* Destructor do Estilo */
 /*======================*/
 /**
- * @brief Libera a memoria alocada para um estilo.
+ * @brief Solta uma referência ao estilo; a memória é liberada quando não restam donos.
  * @param e O estilo a ser destruido.
  */
 void estilo_destroi(Estilo e);
 
+/**
+ * @brief Libera todos os estilos existentes, com ou sem donos (ex: ao liberar a cena inteira).
+ * Todo Estilo obtido antes deixa de valer.
+ */
+void estilo_libera_todos(void);
+
 
 
 /*======================*/
@@ -5,11 +5,15 @@
 #include "lista.h"
 #include "geometria.h"
 #include "poligono.h"
+#include "cores.h"
+#include "arena.h"
 
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stddef.h>
+#include <pthread.h>
 
 /*======================*/
 /*  Structs das formas  */ 
@@ -24,22 +28,22 @@ typedef enum {
 
 typedef struct {
     double x, y, r;
-    char *corb, *corp;
+    IdCor corb, corp;
 } EstruturaCirculo;
 
 typedef struct {
     double x, y, w, h;
-    char *corb, *corp;
+    IdCor corb, corp;
 } EstruturaRetangulo;
 
 typedef struct {
     double x1, y1, x2, y2;
-    char *cor;
+    IdCor cor;
 } EstruturaLinha;
 
 typedef struct {
     double x, y;
-    char *corb, *corp;
+    IdCor corb, corp;
     char a;
     char *txto;
     Estilo estilo;
@@ -57,27 +61,161 @@ typedef struct {
 } EstruturaForma;
 
 /*======================*/
-/* Funções Auxiliares   */
+/*  Memória da cena     */
 /*======================*/
 
-/**
- * @brief Duplica uma string (versão C99-compatível do strdup).
- * @param s String a ser duplicada.
- * @return char* Nova string alocada, ou NULL em caso de erro.
- */
-static char* duplicar_string(const char* s) {
-    if (s == NULL) {
-        return NULL;
+/*
+* Todas as formas e seus textos vêm de uma arena única da cena. Cada forma ocupa só o
+* cabeçalho mais os dados do seu tipo, e as formas destruídas voltam para uma lista de
+* livres do tipo, reaproveitada pela próxima forma igual. O conteúdo dos textos nunca é
+* alterado depois de criado, então clones dividem a mesma string; ela só é devolvida
+* junto com a arena, em formas_libera_cena. A trava protege a arena e as listas.
+* As threads de leitura do .geo não passam pela trava: cada uma aloca em uma arena
+* própria (a carga, guardada na chave da thread), juntada à da cena depois do join.
+*/
+static Arena arena_cena = NULL;
+static void* livres_por_tipo[4];
+static pthread_mutex_t trava_cena = PTHREAD_MUTEX_INITIALIZER;
+static long long alocacoes_cena = 0;     // Formas alocadas desde o início (para --stats)
+
+typedef struct {
+    Arena arena;
+    long long alocacoes;
+} EstruturaCarga;
+
+static pthread_key_t chave_carga;
+static pthread_once_t chave_carga_criada = PTHREAD_ONCE_INIT;
+
+static void cria_chave_carga(void) {
+    pthread_key_create(&chave_carga, NULL);
+}
+
+static EstruturaCarga* carga_da_thread(void) {
+    pthread_once(&chave_carga_criada, cria_chave_carga);
+    return (EstruturaCarga*) pthread_getspecific(chave_carga);
+}
+
+static size_t tamanho_forma(TipoForma tipo) {
+    size_t base = offsetof(EstruturaForma, dados);
+    switch (tipo) {
+        case TIPO_CIRCULO:   return base + sizeof(EstruturaCirculo);
+        case TIPO_RETANGULO: return base + sizeof(EstruturaRetangulo);
+        case TIPO_LINHA:     return base + sizeof(EstruturaLinha);
+        case TIPO_TEXTO:     return base + sizeof(EstruturaTexto);
     }
+    return sizeof(EstruturaForma);
+}
 
-    size_t len = strlen(s) + 1; 
-    char* nova_string = (char*) malloc(len);
-    if (nova_string == NULL) {
-        return NULL;
+static EstruturaForma* aloca_forma(TipoForma tipo) {
+    EstruturaForma* forma = NULL;
+
+    EstruturaCarga* carga = carga_da_thread();
+    if (carga != NULL) {
+        forma = (EstruturaForma*) arena_aloca(carga->arena, tamanho_forma(tipo));
+        carga->alocacoes++;
+        if (forma != NULL) {
+            forma->tipo = tipo;
+        }
+        return forma;
+    }
+
+    pthread_mutex_lock(&trava_cena);
+    if (livres_por_tipo[tipo] != NULL) {
+        // A forma livre guarda no começo o ponteiro para a próxima
+        forma = (EstruturaForma*) livres_por_tipo[tipo];
+        livres_por_tipo[tipo] = *(void**) forma;
+    } else {
+        if (arena_cena == NULL) {
+            arena_cena = arena_cria(0);
+        }
+        forma = (EstruturaForma*) arena_aloca(arena_cena, tamanho_forma(tipo));
+    }
+    alocacoes_cena++;
+    pthread_mutex_unlock(&trava_cena);
+
+    if (forma != NULL) {
+        forma->tipo = tipo;
+    }
+    return forma;
+}
+
+static char* aloca_texto(const char* s) {
+    EstruturaCarga* carga = carga_da_thread();
+    if (carga != NULL) {
+        return arena_duplica_string(carga->arena, s);
     }
 
-    strcpy(nova_string, s);
-    return nova_string;
+    pthread_mutex_lock(&trava_cena);
+    if (arena_cena == NULL) {
+        arena_cena = arena_cria(0);
+    }
+    char* copia = arena_duplica_string(arena_cena, s);
+    pthread_mutex_unlock(&trava_cena);
+    return copia;
+}
+
+static void recicla_forma(EstruturaForma* forma) {
+    TipoForma tipo = forma->tipo;
+    pthread_mutex_lock(&trava_cena);
+    *(void**) forma = livres_por_tipo[tipo];
+    livres_por_tipo[tipo] = forma;
+    pthread_mutex_unlock(&trava_cena);
+}
+
+void formas_libera_cena(void) {
+    pthread_mutex_lock(&trava_cena);
+    arena_destroi(arena_cena);
+    arena_cena = NULL;
+    for (int i = 0; i < 4; i++) {
+        livres_por_tipo[i] = NULL;
+    }
+    pthread_mutex_unlock(&trava_cena);
+}
+
+void formas_uso_cena(long long* alocacoes, size_t* bytes_reservados) {
+    pthread_mutex_lock(&trava_cena);
+    if (alocacoes) *alocacoes = alocacoes_cena;
+    if (bytes_reservados) *bytes_reservados = arena_bytes_reservados(arena_cena);
+    pthread_mutex_unlock(&trava_cena);
+}
+
+void formas_inicia_carga(void) {
+    if (carga_da_thread() != NULL) return;
+
+    EstruturaCarga* carga = (EstruturaCarga*) malloc(sizeof(EstruturaCarga));
+    Arena arena = arena_cria(0);
+    if (carga == NULL || arena == NULL || pthread_setspecific(chave_carga, carga) != 0) {
+        // Sem carga a thread continua alocando na arena da cena, com trava
+        printf("Erro ao criar a arena da thread de leitura\n");
+        free(carga);
+        arena_destroi(arena);
+        return;
+    }
+    carga->arena = arena;
+    carga->alocacoes = 0;
+}
+
+CargaFormas formas_encerra_carga(void) {
+    EstruturaCarga* carga = carga_da_thread();
+    if (carga != NULL) {
+        pthread_setspecific(chave_carga, NULL);
+    }
+    return (CargaFormas) carga;
+}
+
+void formas_junta_carga(CargaFormas c) {
+    EstruturaCarga* carga = (EstruturaCarga*) c;
+    if (carga == NULL) return;
+
+    pthread_mutex_lock(&trava_cena);
+    if (arena_cena == NULL) {
+        arena_cena = carga->arena;
+    } else {
+        arena_junta(arena_cena, carga->arena);
+    }
+    alocacoes_cena += carga->alocacoes;
+    pthread_mutex_unlock(&trava_cena);
+    free(carga);
 }
 
 /*==========================*/
@@ -86,78 +224,74 @@ static char* duplicar_string(const char* s) {
 
 
 Forma circulo_cria(int i, double x, double y, double r, char *corb, char *corp) {
-    EstruturaForma *NovoCirculo = (EstruturaForma*) malloc(sizeof(EstruturaForma));
+    EstruturaForma *NovoCirculo = aloca_forma(TIPO_CIRCULO);
     if (NovoCirculo == NULL) {
         printf("Erro ao alocar circulo em circulo_cria\n");
         return NULL;
     }
 
-    NovoCirculo->tipo = TIPO_CIRCULO;
     NovoCirculo->id = i;
     NovoCirculo->dados.circulo.r = r;
     NovoCirculo->dados.circulo.x = x;
     NovoCirculo->dados.circulo.y = y;
-    NovoCirculo->dados.circulo.corb = duplicar_string(corb);
-    NovoCirculo->dados.circulo.corp = duplicar_string(corp);
+    NovoCirculo->dados.circulo.corb = cores_interna(corb);
+    NovoCirculo->dados.circulo.corp = cores_interna(corp);
     
     return (Forma)NovoCirculo;
 }
 
  
 Forma retangulo_cria(int i, double x, double y, double w, double h, char *corb, char *corp) {
-    EstruturaForma *NovoRetangulo = (EstruturaForma*) malloc(sizeof(EstruturaForma));
+    EstruturaForma *NovoRetangulo = aloca_forma(TIPO_RETANGULO);
     if (NovoRetangulo == NULL) {
         printf("Erro ao alocar retangulo em retangulo_cria\n");
         return NULL;
     }
 
-    NovoRetangulo->tipo = TIPO_RETANGULO;
     NovoRetangulo->id = i;
     NovoRetangulo->dados.retangulo.x = x;
     NovoRetangulo->dados.retangulo.y = y;
     NovoRetangulo->dados.retangulo.w = w;
     NovoRetangulo->dados.retangulo.h = h;
-    NovoRetangulo->dados.retangulo.corb = duplicar_string(corb);
-    NovoRetangulo->dados.retangulo.corp = duplicar_string(corp);
+    NovoRetangulo->dados.retangulo.corb = cores_interna(corb);
+    NovoRetangulo->dados.retangulo.corp = cores_interna(corp);
 
     return (Forma)NovoRetangulo;
 }
 
 
 Forma linha_cria(int i, double x1, double y1, double x2, double y2, char *cor) {
-    EstruturaForma *NovaLinha = (EstruturaForma*) malloc(sizeof(EstruturaForma));
+    EstruturaForma *NovaLinha = aloca_forma(TIPO_LINHA);
     if (NovaLinha == NULL) {
         printf("Erro ao alocar linha em linha_cria\n");
         return NULL;
     }
 
-    NovaLinha->tipo = TIPO_LINHA;
     NovaLinha->id = i;
     NovaLinha->dados.linha.x1 = x1;
     NovaLinha->dados.linha.x2 = x2;
     NovaLinha->dados.linha.y1 = y1;
     NovaLinha->dados.linha.y2 = y2;
-    NovaLinha->dados.linha.cor = duplicar_string(cor);
+    NovaLinha->dados.linha.cor = cores_interna(cor);
 
     return (Forma)NovaLinha;
 }
 
 
 Forma texto_cria(int i, double x, double y, char* corb, char *corp, char a, char *txto, Estilo e) {
-    EstruturaForma *NovoTexto = (EstruturaForma*) malloc(sizeof(EstruturaForma));
+    EstruturaForma *NovoTexto = aloca_forma(TIPO_TEXTO);
     if (NovoTexto == NULL) {
         printf("Erro ao alocar texto em texto_cria\n");
         return NULL;
     }
 
-    NovoTexto->tipo = TIPO_TEXTO;
     NovoTexto->id = i;
     NovoTexto->dados.texto.x = x;
     NovoTexto->dados.texto.y = y;
-    NovoTexto->dados.texto.corb = duplicar_string(corb);
-    NovoTexto->dados.texto.corp = duplicar_string(corp);
+    NovoTexto->dados.texto.corb = cores_interna(corb);
+    NovoTexto->dados.texto.corp = cores_interna(corp);
     NovoTexto->dados.texto.a = a;
-    NovoTexto->dados.texto.txto = duplicar_string(txto);
+    NovoTexto->dados.texto.txto = aloca_texto(txto);
     NovoTexto->dados.texto.estilo = e;
 
     return (Forma)NovoTexto;
@@ -174,30 +308,12 @@ void forma_destroi(Forma f) {
         return;
     }
 
-    switch (forma->tipo) {
-        case TIPO_CIRCULO:
-            free(forma->dados.circulo.corb);
-            free(forma->dados.circulo.corp);
-            break;
-
-        case TIPO_RETANGULO:
-            free(forma->dados.retangulo.corb);
-            free(forma->dados.retangulo.corp);
-            break;
-            
-        case TIPO_LINHA:
-            free(forma->dados.linha.cor); 
-            break;
-            
-        case TIPO_TEXTO:
-            free(forma->dados.texto.corb);
-            free(forma->dados.texto.corp);
-            free(forma->dados.texto.txto); 
-            estilo_destroi(forma->dados.texto.estilo);
-            break;
+    // As cores são ids da tabela global e o texto fica na arena: só o estilo é solto
+    if (forma->tipo == TIPO_TEXTO) {
+        estilo_destroi(forma->dados.texto.estilo);
     }
 
-    free(forma); 
+    recicla_forma(forma);
 }
 
 /*====================*/
@@ -223,17 +339,17 @@ char* forma_getCorPreenchimento(Forma f) {
 
     switch (forma->tipo) {
         case TIPO_CIRCULO:
-            return forma->dados.circulo.corp;
+            return (char*) cores_texto(forma->dados.circulo.corp);
        
         case TIPO_RETANGULO:
-            return forma->dados.retangulo.corp;
+            return (char*) cores_texto(forma->dados.retangulo.corp);
 
         case TIPO_LINHA:
             // Linha não tem preenchimento, retorna a cor da linha
-            return forma->dados.linha.cor;
+            return (char*) cores_texto(forma->dados.linha.cor);
 
         case TIPO_TEXTO:
-            return forma->dados.texto.corp;
+            return (char*) cores_texto(forma->dados.texto.corp);
     }
 
     return NULL;
@@ -249,16 +365,16 @@ char* forma_getCorBorda(Forma f) {
 
     switch (forma->tipo) {
         case TIPO_CIRCULO:
-            return forma->dados.circulo.corb;
+            return (char*) cores_texto(forma->dados.circulo.corb);
        
         case TIPO_RETANGULO:
-            return forma->dados.retangulo.corb;
+            return (char*) cores_texto(forma->dados.retangulo.corb);
 
         case TIPO_LINHA:
-            return forma->dados.linha.cor;
+            return (char*) cores_texto(forma->dados.linha.cor);
 
         case TIPO_TEXTO:
-            return forma->dados.texto.corb;
+            return (char*) cores_texto(forma->dados.texto.corb);
     }
 
     return NULL;
@@ -318,6 +434,60 @@ double forma_getY(Forma f) {
     return -1;
 }
 
+int forma_descreve(Forma f, DescricaoForma* d) {
+    EstruturaForma* forma = (EstruturaForma*) f;
+    if (f == NULL || d == NULL) {
+        printf("Erro em forma_descreve\n");
+        return 0;
+    }
+
+    memset(d, 0, sizeof(DescricaoForma));
+    d->id = forma->id;
+
+    switch (forma->tipo) {
+        case TIPO_CIRCULO:
+            d->tipo = 'c';
+            d->v[0] = forma->dados.circulo.x;
+            d->v[1] = forma->dados.circulo.y;
+            d->v[2] = forma->dados.circulo.r;
+            d->corb = (char*) cores_texto(forma->dados.circulo.corb);
+            d->corp = (char*) cores_texto(forma->dados.circulo.corp);
+            return 1;
+
+        case TIPO_RETANGULO:
+            d->tipo = 'r';
+            d->v[0] = forma->dados.retangulo.x;
+            d->v[1] = forma->dados.retangulo.y;
+            d->v[2] = forma->dados.retangulo.w;
+            d->v[3] = forma->dados.retangulo.h;
+            d->corb = (char*) cores_texto(forma->dados.retangulo.corb);
+            d->corp = (char*) cores_texto(forma->dados.retangulo.corp);
+            return 1;
+
+        case TIPO_LINHA:
+            d->tipo = 'l';
+            d->v[0] = forma->dados.linha.x1;
+            d->v[1] = forma->dados.linha.y1;
+            d->v[2] = forma->dados.linha.x2;
+            d->v[3] = forma->dados.linha.y2;
+            d->corb = (char*) cores_texto(forma->dados.linha.cor);
+            return 1;
+
+        case TIPO_TEXTO:
+            d->tipo = 't';
+            d->v[0] = forma->dados.texto.x;
+            d->v[1] = forma->dados.texto.y;
+            d->corb = (char*) cores_texto(forma->dados.texto.corb);
+            d->corp = (char*) cores_texto(forma->dados.texto.corp);
+            d->a = forma->dados.texto.a;
+            d->txto = forma->dados.texto.txto;
+            d->estilo = forma->dados.texto.estilo;
+            return 1;
+    }
+
+    return 0;
+}
+
 /*==================================*/
 /*  Setters e operações das formas  */
 /*==================================*/
@@ -335,31 +505,23 @@ void forma_setCorBorda(Forma f, char* novaCorBorda) {
         return;
     }
 
-    char *novaCorAlocada = duplicar_string(novaCorBorda);
-    if (novaCorAlocada == NULL) {
-        printf("Erro ao alocar memoria em forma_setCorBorda\n");
-        return;
-    } 
+    IdCor cor = cores_interna(novaCorBorda);
 
     switch (forma->tipo) {
         case TIPO_CIRCULO:
-            free(forma->dados.circulo.corb);
-            forma->dados.circulo.corb = novaCorAlocada;
+            forma->dados.circulo.corb = cor;
             return;
 
         case TIPO_RETANGULO:
-            free(forma->dados.retangulo.corb);
-            forma->dados.retangulo.corb = novaCorAlocada;
+            forma->dados.retangulo.corb = cor;
             return;
 
         case TIPO_LINHA:
-            free(forma->dados.linha.cor);
-            forma->dados.linha.cor = novaCorAlocada;
+            forma->dados.linha.cor = cor;
             return;
         
         case TIPO_TEXTO:
-            free(forma->dados.texto.corb);
-            forma->dados.texto.corb = novaCorAlocada;
+            forma->dados.texto.corb = cor;
             return;
     }
 }
@@ -377,37 +539,62 @@ void forma_setCorPreenchimento(Forma f, char* novaCorPreenchimento) {
         return;
     }
 
-    char *novaCorAlocada = duplicar_string(novaCorPreenchimento);
-    if (novaCorAlocada == NULL) {
-        printf("Erro ao alocar memoria em forma_setCorPreenchimento\n");
+    IdCor cor = cores_interna(novaCorPreenchimento);
+
+    switch (forma->tipo) {
+        case TIPO_CIRCULO:
+            forma->dados.circulo.corp = cor;
+            return;
+
+        case TIPO_RETANGULO:
+            forma->dados.retangulo.corp = cor;
+            return;
+
+        case TIPO_LINHA:
+            // Linha não tem preenchimento
+            return;
+        
+        case TIPO_TEXTO:
+            forma->dados.texto.corp = cor;
+            return;
+    }
+}
+
+
+void forma_pinta(Forma f, IdCor cor) {
+    EstruturaForma* forma = (EstruturaForma*) f;
+    if (f == NULL) {
+        printf("Erro: forma nula em forma_pinta\n");
+        return;
+    }
+
+    const char* texto = cores_texto(cor);
+    if (texto == NULL || texto[0] != '#') {
+        printf("Erro: cor invalida em forma_pinta\n");
         return;
     }
 
     switch (forma->tipo) {
         case TIPO_CIRCULO:
-            free(forma->dados.circulo.corp);
-            forma->dados.circulo.corp = novaCorAlocada;
+            forma->dados.circulo.corb = forma->dados.circulo.corp = cor;
             return;
 
         case TIPO_RETANGULO:
-            free(forma->dados.retangulo.corp);
-            forma->dados.retangulo.corp = novaCorAlocada;
+            forma->dados.retangulo.corb = forma->dados.retangulo.corp = cor;
             return;
 
         case TIPO_LINHA:
-            // Linha não tem preenchimento
-            free(novaCorAlocada);
+            forma->dados.linha.cor = cor;
             return;
         
         case TIPO_TEXTO:
-            free(forma->dados.texto.corp);
-            forma->dados.texto.corp = novaCorAlocada;
+            forma->dados.texto.corb = forma->dados.texto.corp = cor;
             return;
     }
 }
 
 
-void forma_desenhaSvg(Forma f, FILE* svg_file) {
+void forma_desenhaSvg(Forma f, EscritorSvg svg_file) {
     EstruturaForma *forma = (EstruturaForma*) f; 
     if (forma == NULL || svg_file == NULL) {
         return;
@@ -418,27 +605,27 @@ void forma_desenhaSvg(Forma f, FILE* svg_file) {
             svg_desenha_circulo(svg_file,
                 forma->dados.circulo.x, forma->dados.circulo.y,
                 forma->dados.circulo.r,
-                forma->dados.circulo.corb, forma->dados.circulo.corp);
+                (char*) cores_texto(forma->dados.circulo.corb), (char*) cores_texto(forma->dados.circulo.corp));
             break;
             
         case TIPO_RETANGULO:
             svg_desenha_retangulo(svg_file,
                 forma->dados.retangulo.x, forma->dados.retangulo.y,
                 forma->dados.retangulo.w, forma->dados.retangulo.h,
-                forma->dados.retangulo.corb, forma->dados.retangulo.corp);
+                (char*) cores_texto(forma->dados.retangulo.corb), (char*) cores_texto(forma->dados.retangulo.corp));
             break;
             
         case TIPO_LINHA:
             svg_desenha_linha(svg_file,
                 forma->dados.linha.x1, forma->dados.linha.y1,
                 forma->dados.linha.x2, forma->dados.linha.y2,
-                forma->dados.linha.cor);
+                (char*) cores_texto(forma->dados.linha.cor));
             break;
             
         case TIPO_TEXTO:
             svg_desenha_texto(svg_file,
                 forma->dados.texto.x, forma->dados.texto.y,
-                forma->dados.texto.corb, forma->dados.texto.corp,
+                (char*) cores_texto(forma->dados.texto.corb), (char*) cores_texto(forma->dados.texto.corp),
                 forma->dados.texto.txto,
                 estilo_getFamily(forma->dados.texto.estilo),
                 estilo_getWeight(forma->dados.texto.estilo),
@@ -506,64 +693,63 @@ Forma forma_clonar(Forma original, double dx, double dy) {
         return NULL;
     }
 
-    int novoId = proximo_id_clone++;
+    EstruturaForma *clone = aloca_forma(forma->tipo);
+    if (clone == NULL) {
+        printf("Erro ao alocar clone em forma_clonar\n");
+        return NULL;
+    }
+
+    // Copia tudo (inclusive os ids de cor e o texto) e só desloca a posição
+    memcpy(clone, forma, tamanho_forma(forma->tipo));
+    clone->id = proximo_id_clone++;
 
     switch (forma->tipo) {
         case TIPO_CIRCULO:
-            return circulo_cria(novoId, 
-                                forma->dados.circulo.x + dx, 
-                                forma->dados.circulo.y + dy, 
-                                forma->dados.circulo.r, 
-                                forma->dados.circulo.corb, 
-                                forma->dados.circulo.corp);
+            clone->dados.circulo.x += dx;
+            clone->dados.circulo.y += dy;
+            break;
 
         case TIPO_RETANGULO:
-            return retangulo_cria(novoId, 
-                                  forma->dados.retangulo.x + dx, 
-                                  forma->dados.retangulo.y + dy, 
-                                  forma->dados.retangulo.w, 
-                                  forma->dados.retangulo.h, 
-                                  forma->dados.retangulo.corb, 
-                                  forma->dados.retangulo.corp);
+            clone->dados.retangulo.x += dx;
+            clone->dados.retangulo.y += dy;
+            break;
 
         case TIPO_LINHA:
-            return linha_cria(novoId, 
-                              forma->dados.linha.x1 + dx, 
-                              forma->dados.linha.y1 + dy, 
-                              forma->dados.linha.x2 + dx, 
-                              forma->dados.linha.y2 + dy, 
-                              forma->dados.linha.cor);
+            clone->dados.linha.x1 += dx;
+            clone->dados.linha.y1 += dy;
+            clone->dados.linha.x2 += dx;
+            clone->dados.linha.y2 += dy;
+            break;
 
         case TIPO_TEXTO:
-            return texto_cria(novoId, 
-                              forma->dados.texto.x + dx, 
-                              forma->dados.texto.y + dy, 
-                              forma->dados.texto.corb, 
-                              forma->dados.texto.corp, 
-                              forma->dados.texto.a, 
-                              forma->dados.texto.txto, 
-                              estilo_clona(forma->dados.texto.estilo));
+            clone->dados.texto.x += dx;
+            clone->dados.texto.y += dy;
+            clone->dados.texto.estilo = estilo_referencia(forma->dados.texto.estilo);
+            break;
     }
 
-    return NULL;
+    return (Forma)clone;
 }
 
 // Contador global para IDs únicos de anteparos
 static int proximo_id_anteparo = 100000;
 
 
-Lista forma_para_anteparos(Forma f, char orientacao) {
+int forma_para_anteparos(Forma f, char orientacao, ConjuntoAnteparos destino) {
     EstruturaForma* forma = (EstruturaForma*)f;
-    if (forma == NULL) {
-        return NULL;
+    if (forma == NULL || destino == NULL) {
+        return 0;
     }
     
-    Lista anteparos = lista_cria();
-    if (anteparos == NULL) {
-        return NULL;
-    }
+    int n = 0;
     
-    char* cor = forma_getCorBorda(f);
+    IdCor cor;
+    switch (forma->tipo) {
+        case TIPO_CIRCULO:   cor = forma->dados.circulo.corb; break;
+        case TIPO_RETANGULO: cor = forma->dados.retangulo.corb; break;
+        case TIPO_LINHA:     cor = forma->dados.linha.cor; break;
+        default:             cor = forma->dados.texto.corb; break;
+    }
     
     switch (forma->tipo) {
         
@@ -572,16 +758,13 @@ Lista forma_para_anteparos(Forma f, char orientacao) {
             double cy = forma->dados.circulo.y;
             double r = forma->dados.circulo.r;
             
-            Anteparo ant;
             if (orientacao == 'h') {
                 // Segmento horizontal: passa pelo centro
-                ant = anteparo_cria(proximo_id_anteparo++, cx - r, cy, cx + r, cy, cor);
+                n += conjunto_anteparos_adiciona(destino, proximo_id_anteparo++, cx - r, cy, cx + r, cy, cor);
             } else {  // 'v'
                 // Segmento vertical: passa pelo centro
-                ant = anteparo_cria(proximo_id_anteparo++, cx, cy - r, cx, cy + r, cor);
+                n += conjunto_anteparos_adiciona(destino, proximo_id_anteparo++, cx, cy - r, cx, cy + r, cor);
             }
-            
-            lista_adiciona(anteparos, ant);
             break;
         }
         
@@ -592,27 +775,22 @@ Lista forma_para_anteparos(Forma f, char orientacao) {
             double h = forma->dados.retangulo.h;
             
             // Lado superior
-            Anteparo ant1 = anteparo_cria(proximo_id_anteparo++, x, y, x + w, y, cor);
-            lista_adiciona(anteparos, ant1);
+            n += conjunto_anteparos_adiciona(destino, proximo_id_anteparo++, x, y, x + w, y, cor);
             
             // Lado direito
-            Anteparo ant2 = anteparo_cria(proximo_id_anteparo++, x + w, y, x + w, y + h, cor);
-            lista_adiciona(anteparos, ant2);
+            n += conjunto_anteparos_adiciona(destino, proximo_id_anteparo++, x + w, y, x + w, y + h, cor);
             
             // Lado inferior
-            Anteparo ant3 = anteparo_cria(proximo_id_anteparo++, x + w, y + h, x, y + h, cor);
-            lista_adiciona(anteparos, ant3);
+            n += conjunto_anteparos_adiciona(destino, proximo_id_anteparo++, x + w, y + h, x, y + h, cor);
             
             // Lado esquerdo
-            Anteparo ant4 = anteparo_cria(proximo_id_anteparo++, x, y + h, x, y, cor);
-            lista_adiciona(anteparos, ant4);
+            n += conjunto_anteparos_adiciona(destino, proximo_id_anteparo++, x, y + h, x, y, cor);
             break;
         }
         
         case TIPO_LINHA: {
             // Linha já é um segmento
-            Anteparo ant = anteparo_cria(proximo_id_anteparo++, forma->dados.linha.x1, forma->dados.linha.y1, forma->dados.linha.x2, forma->dados.linha.y2, cor);
-            lista_adiciona(anteparos, ant);
+            n += conjunto_anteparos_adiciona(destino, proximo_id_anteparo++, forma->dados.linha.x1, forma->dados.linha.y1, forma->dados.linha.x2, forma->dados.linha.y2, cor);
             break;
         }
         
@@ -620,13 +798,12 @@ Lista forma_para_anteparos(Forma f, char orientacao) {
             // Converte texto em segmento
             SegmentoCoords seg = get_texto_segmento(&forma->dados.texto);
             
-            Anteparo ant = anteparo_cria(proximo_id_anteparo++, seg.x1, seg.y1, seg.x2, seg.y2, cor);
-            lista_adiciona(anteparos, ant);
+            n += conjunto_anteparos_adiciona(destino, proximo_id_anteparo++, seg.x1, seg.y1, seg.x2, seg.y2, cor);
             break;
         }
     }
     
-    return anteparos;
+    return n;
 }
 
 
@@ -683,6 +860,14 @@ int forma_sobrepoe_visibilidade(Forma f, Poligono vis) {
         return 0;
     }
 
+    return forma_sobrepoe_visibilidade_candidata(f, vis);
+}
+
+int forma_sobrepoe_visibilidade_candidata(Forma f, Poligono vis) {
+    if (f == NULL || vis == NULL) return 0;
+
+    EstruturaForma* forma = (EstruturaForma*)f;
+
     switch (forma->tipo) {
         case TIPO_CIRCULO: {
             double cx = forma->dados.circulo.x;
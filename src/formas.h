@@ -5,6 +5,8 @@
 #include "anteparo.h"
 #include "lista.h"
 #include "poligono.h"
+#include "svg.h"
+#include "cores.h"
 #include <stdio.h>
 
 /*
@@ -17,6 +19,26 @@
 
 typedef void* Forma;
 
+/*
+* Memória das formas criadas por uma thread de leitura, até ser juntada à cena.
+*/
+typedef void* CargaFormas;
+
+/*
+* Descrição completa de uma forma, com os mesmos campos dos construtores.
+* Usada para serializar as formas (ex: formato binário .geob) sem expor a estrutura interna.
+* As strings e o estilo apontam para os da forma: não devem ser liberados nem alterados.
+*/
+typedef struct {
+    char tipo;               // 'c', 'r', 'l' ou 't' (como no .geo)
+    int id;
+    double v[4];             // c: x y r | r: x y w h | l: x1 y1 x2 y2 | t: x y
+    char *corb, *corp;       // Linha: a cor fica em corb
+    char a;                  // Âncora do texto
+    char *txto;
+    Estilo estilo;           // Apenas textos (NULL nas demais)
+} DescricaoForma;
+
 /*==========================*/
 /* Construtores            */
 /*==========================*/
@@ -71,11 +93,43 @@ Forma texto_cria(int i, double x, double y, char *corb, char *corp, char a, char
 /* Destrutor               */
 /*==========================*/
 /**
- * @brief Destrói a forma e libera seus recursos (strings, estruturas).
+ * @brief Destrói a forma: a memória volta para as livres da cena e o estilo do texto é solto.
  * @param f A forma a ser destruída.
  */
 void forma_destroi(Forma f);
 
+/**
+ * @brief Libera de uma vez a memória de todas as formas (a arena da cena), sem percorrê-las.
+ * Toda Forma ainda existente deixa de valer; os estilos dos textos devem ser soltos à
+ * parte (estilo_libera_todos).
+ */
+void formas_libera_cena(void);
+
+/**
+ * @brief Informa o uso de memória da cena.
+ * @param alocacoes Onde escrever quantas formas foram alocadas até agora (pode ser NULL).
+ * @param bytes_reservados Onde escrever os bytes reservados pela arena (pode ser NULL).
+ */
+void formas_uso_cena(long long* alocacoes, size_t* bytes_reservados);
+
+/**
+ * @brief Faz a thread atual alocar as formas que criar em uma arena própria, sem trava.
+ * Usada pelas threads de leitura do .geo; encerrada com formas_encerra_carga.
+ */
+void formas_inicia_carga(void);
+
+/**
+ * @brief Volta a thread atual para a arena da cena e devolve a memória que ela usou.
+ * @return CargaFormas A carga, a ser juntada com formas_junta_carga (NULL se não havia).
+ */
+CargaFormas formas_encerra_carga(void);
+
+/**
+ * @brief Junta a memória de uma carga à arena da cena (depois do join da thread).
+ * As formas da carga continuam valendo e passam a ser liberadas com a cena.
+ */
+void formas_junta_carga(CargaFormas carga);
+
 /*==========================*/
 /* Getters e Setters       */
 /*==========================*/
@@ -111,6 +165,22 @@ void forma_setCorBorda(Forma f, char* cor);
  */
 void forma_setCorPreenchimento(Forma f, char* cor);
 
+/**
+ * @brief Pinta a forma: borda e preenchimento recebem a mesma cor (na linha, a cor da linha).
+ * Só troca ids, sem alocar; a cor precisa começar com '#', como nos setters acima.
+ * @param f A forma.
+ * @param cor Id da cor na tabela de cores.
+ */
+void forma_pinta(Forma f, IdCor cor);
+
+/**
+ * @brief Preenche uma DescricaoForma com todos os dados da forma.
+ * @param f A forma.
+ * @param d A descrição a ser preenchida.
+ * @return int 1 em caso de sucesso, 0 se a forma for inválida.
+ */
+int forma_descreve(Forma f, DescricaoForma* d);
+
 /*==========================*/
 /* Operações Avançadas     */
 /*==========================*/
@@ -118,9 +188,9 @@ void forma_setCorPreenchimento(Forma f, char* cor);
 /**
  * @brief Desenha a forma no arquivo SVG fornecido.
  * @param f A forma.
- * @param svg O arquivo aberto.
+ * @param svg O escritor do arquivo SVG aberto.
  */
-void forma_desenhaSvg(Forma f, FILE* svg);
+void forma_desenhaSvg(Forma f, EscritorSvg svg);
 
 /**
  * @brief Cria um clone de uma forma, transladando-a.
@@ -137,10 +207,12 @@ Forma forma_clonar(Forma original, double dx, double dy);
  * - Linhas geram 1 anteparo.
  * - Textos geram o "Bounding Box" como anteparos.
  * - Círculos: Geralmente aproximados ou tratados como 1 anteparo (dependendo da regra do projeto).
- * * @param f A forma a ser convertida.
- * @param l A lista onde os novos anteparos serão inseridos.
+ * @param f A forma a ser convertida.
+ * @param orientacao 'h' ou 'v' (orientação do segmento de um círculo).
+ * @param destino O conjunto onde os novos anteparos serão acrescentados.
+ * @return int Número de anteparos acrescentados.
  */
-Lista forma_para_anteparos(Forma f, char orientacao);
+int forma_para_anteparos(Forma f, char orientacao, ConjuntoAnteparos destino);
 
 /**
  * @brief Verifica se uma forma sobrepõe parcialmente com uma região de visibilidade
@@ -150,4 +222,14 @@ Lista forma_para_anteparos(Forma f, char orientacao);
  */
 int forma_sobrepoe_visibilidade(Forma f, Poligono vis);
 
+/**
+ * @brief Como forma_sobrepoe_visibilidade, mas sem o teste de caixas envolventes.
+ * Para formas que já passaram por esse filtro (ex: tabela_formas_candidatas), evitando
+ * recalcular a caixa do polígono para cada forma.
+ * @param f Forma a testar
+ * @param vis Polígono da região de visibilidade
+ * @return 1 se sobrepõe, 0 caso contrário
+ */
+int forma_sobrepoe_visibilidade_candidata(Forma f, Poligono vis);
+
 #endif
\ No newline at end of file
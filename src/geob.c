@@ -0,0 +1,466 @@
+#include "geob.h"
+#include "formas.h"
+#include "estilo.h"
+#include "leitor.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define GEOB_MARCA_ENDIAN 0x01020304u
+#define GEOB_SEM_ESTILO (-1)
+
+// Soma de verificação: FNV-1a aplicado a palavras de 64 bits.
+#define SOMA_INICIAL 0xcbf29ce484222325ULL
+#define SOMA_PRIMO 0x100000001b3ULL
+
+/*
+* Layout do arquivo (todos os blocos com tamanho múltiplo de 8 bytes):
+*   CabecalhoGeob | RegistroGeob[n_formas] | RegistroEstilo[n_estilos] | strings
+* As strings são terminadas em '\0' e referenciadas por deslocamento; o deslocamento 0
+* é sempre a string vazia.
+*/
+typedef struct {
+    char magica[4];          // "GEOB"
+    uint32_t versao;
+    uint32_t marca_endian;
+    uint32_t tam_registro;   // sizeof(RegistroGeob): detecta mudanças de layout
+    uint64_t n_formas;
+    uint64_t n_estilos;
+    uint64_t tam_strings;
+    uint64_t soma_dados;     // Soma dos blocos após o cabeçalho
+    uint64_t soma_cabecalho; // Soma do cabeçalho com este campo zerado
+} CabecalhoGeob;
+
+typedef struct {
+    uint32_t tipo;           // 'c', 'r', 'l' ou 't'
+    int32_t id;
+    double v[4];
+    uint32_t corb, corp, txto;
+    int32_t estilo;          // Índice na tabela de estilos, ou GEOB_SEM_ESTILO
+    int32_t a;
+    uint32_t reservado;
+} RegistroGeob;
+
+typedef struct {
+    uint32_t family, weight;
+    double size;
+} RegistroEstilo;
+
+/*==========================*/
+/* Soma de Verificação      */
+/*==========================*/
+
+// 'n' deve ser múltiplo de 8
+static uint64_t soma_atualiza(uint64_t soma, const void* dados, size_t n) {
+    const unsigned char* p = (const unsigned char*) dados;
+    for (size_t i = 0; i < n; i += 8) {
+        uint64_t palavra;
+        memcpy(&palavra, p + i, 8);
+        soma = (soma ^ palavra) * SOMA_PRIMO;
+    }
+    return soma;
+}
+
+/*==========================*/
+/* Bloco de Strings         */
+/*==========================*/
+
+// Strings sem repetição, com tabela hash (endereçamento aberto) de deslocamentos
+typedef struct {
+    char* dados;
+    size_t tamanho, capacidade;
+    uint32_t* tabela;        // 0 = vazio (o deslocamento 0 é a string vazia, tratada à parte)
+    size_t cap_tabela, ocupados;
+} BlocoStrings;
+
+static uint64_t hash_string(const char* s) {
+    uint64_t h = SOMA_INICIAL;
+    while (*s) {
+        h = (h ^ (unsigned char)*s++) * SOMA_PRIMO;
+    }
+    return h;
+}
+
+static int bloco_inicia(BlocoStrings* b) {
+    b->capacidade = 1 << 16;
+    b->dados = (char*) malloc(b->capacidade);
+    b->cap_tabela = 1 << 12;
+    b->tabela = (uint32_t*) calloc(b->cap_tabela, sizeof(uint32_t));
+    b->ocupados = 0;
+    b->tamanho = 1;
+    if (b->dados == NULL || b->tabela == NULL) {
+        free(b->dados);
+        free(b->tabela);
+        return 0;
+    }
+    b->dados[0] = '\0';
+    return 1;
+}
+
+static void bloco_libera(BlocoStrings* b) {
+    free(b->dados);
+    free(b->tabela);
+}
+
+static int bloco_dobra_tabela(BlocoStrings* b) {
+    size_t nova_cap = b->cap_tabela * 2;
+    uint32_t* nova = (uint32_t*) calloc(nova_cap, sizeof(uint32_t));
+    if (nova == NULL) {
+        return 0;
+    }
+    for (size_t i = 0; i < b->cap_tabela; i++) {
+        uint32_t off = b->tabela[i];
+        if (off == 0) continue;
+        size_t pos = hash_string(b->dados + off) & (nova_cap - 1);
+        while (nova[pos] != 0) pos = (pos + 1) & (nova_cap - 1);
+        nova[pos] = off;
+    }
+    free(b->tabela);
+    b->tabela = nova;
+    b->cap_tabela = nova_cap;
+    return 1;
+}
+
+// Retorna o deslocamento da string no bloco (inserindo se preciso), ou 0 em erro
+static int bloco_adiciona(BlocoStrings* b, const char* s, uint32_t* deslocamento) {
+    if (s == NULL || s[0] == '\0') {
+        *deslocamento = 0;
+        return 1;
+    }
+    
+    if ((b->ocupados + 1) * 2 > b->cap_tabela && !bloco_dobra_tabela(b)) {
+        return 0;
+    }
+    
+    size_t pos = hash_string(s) & (b->cap_tabela - 1);
+    while (b->tabela[pos] != 0) {
+        if (strcmp(b->dados + b->tabela[pos], s) == 0) {
+            *deslocamento = b->tabela[pos];
+            return 1;
+        }
+        pos = (pos + 1) & (b->cap_tabela - 1);
+    }
+    
+    size_t len = strlen(s) + 1;
+    if (b->tamanho + len > UINT32_MAX) {
+        printf("Erro: strings demais para o formato geob\n");
+        return 0;
+    }
+    while (b->tamanho + len > b->capacidade) {
+        char* novo = (char*) realloc(b->dados, b->capacidade * 2);
+        if (novo == NULL) {
+            return 0;
+        }
+        b->dados = novo;
+        b->capacidade *= 2;
+    }
+    
+    memcpy(b->dados + b->tamanho, s, len);
+    b->tabela[pos] = (uint32_t) b->tamanho;
+    b->ocupados++;
+    *deslocamento = (uint32_t) b->tamanho;
+    b->tamanho += len;
+    return 1;
+}
+
+/*==========================*/
+/* Gravação                 */
+/*==========================*/
+
+// Grava 'n' bytes e atualiza a soma dos dados
+static int grava_bloco(FILE* f, const void* dados, size_t n, uint64_t* soma) {
+    *soma = soma_atualiza(*soma, dados, n);
+    return fwrite(dados, 1, n, f) == n;
+}
+
+int geob_grava(Lista formas, const char* caminho) {
+    if (formas == NULL || caminho == NULL) {
+        printf("Erro: parametros invalidos em geob_grava\n");
+        return 0;
+    }
+    
+    int n;
+    void** array = lista_para_array(formas, &n);
+    if (array == NULL && n > 0) {
+        printf("Erro ao obter as formas em geob_grava\n");
+        return 0;
+    }
+    
+    FILE* f = fopen(caminho, "wb");
+    if (f == NULL) {
+        printf("Erro ao criar o arquivo %s\n", caminho);
+        free(array);
+        return 0;
+    }
+    
+    BlocoStrings strings;
+    RegistroEstilo* estilos = NULL;
+    int n_estilos = 0, cap_estilos = 0;
+    uint64_t soma = SOMA_INICIAL;
+    int ok = bloco_inicia(&strings);
+    
+    // Cabeçalho provisório; reescrito no final com contagens e somas
+    CabecalhoGeob cab;
+    memset(&cab, 0, sizeof(cab));
+    ok = ok && fwrite(&cab, sizeof(cab), 1, f) == 1;
+    
+    int n_gravadas = 0;
+    for (int i = 0; ok && i < n; i++) {
+        DescricaoForma d;
+        if (!forma_descreve(array[i], &d)) {
+            continue;
+        }
+        
+        RegistroGeob reg;
+        memset(&reg, 0, sizeof(reg));
+        reg.tipo = (uint32_t)(unsigned char) d.tipo;
+        reg.id = d.id;
+        memcpy(reg.v, d.v, sizeof(reg.v));
+        reg.a = d.a;
+        reg.estilo = GEOB_SEM_ESTILO;
+        ok = bloco_adiciona(&strings, d.corb, &reg.corb) &&
+             bloco_adiciona(&strings, d.corp, &reg.corp) &&
+             bloco_adiciona(&strings, d.txto, &reg.txto);
+        
+        if (ok && d.estilo != NULL) {
+            RegistroEstilo est;
+            memset(&est, 0, sizeof(est));
+            est.size = estilo_getSize(d.estilo);
+            ok = bloco_adiciona(&strings, estilo_getFamily(d.estilo), &est.family) &&
+                 bloco_adiciona(&strings, estilo_getWeight(d.estilo), &est.weight);
+            
+            // O estilo vem do último 'ts': textos seguidos quase sempre repetem o anterior
+            if (ok && n_estilos > 0 && memcmp(&estilos[n_estilos - 1], &est, sizeof(est)) == 0) {
+                reg.estilo = n_estilos - 1;
+            } else if (ok) {
+                if (n_estilos == cap_estilos) {
+                    cap_estilos = cap_estilos == 0 ? 16 : cap_estilos * 2;
+                    RegistroEstilo* novo = (RegistroEstilo*) realloc(estilos, (size_t)cap_estilos * sizeof(RegistroEstilo));
+                    if (novo == NULL) {
+                        ok = 0;
+                        break;
+                    }
+                    estilos = novo;
+                }
+                estilos[n_estilos] = est;
+                reg.estilo = n_estilos++;
+            }
+        }
+        
+        ok = ok && grava_bloco(f, &reg, sizeof(reg), &soma);
+        n_gravadas++;
+    }
+    
+    if (ok) {
+        // Completa o bloco de strings até múltiplo de 8 bytes
+        size_t alinhado = (strings.tamanho + 7) & ~(size_t)7;
+        while (strings.tamanho < alinhado && strings.tamanho < strings.capacidade) {
+            strings.dados[strings.tamanho++] = '\0';
+        }
+        ok = strings.tamanho == alinhado &&
+             grava_bloco(f, estilos, (size_t)n_estilos * sizeof(RegistroEstilo), &soma) &&
+             grava_bloco(f, strings.dados, strings.tamanho, &soma);
+    }
+    
+    if (ok) {
+        memcpy(cab.magica, "GEOB", 4);
+        cab.versao = GEOB_VERSAO;
+        cab.marca_endian = GEOB_MARCA_ENDIAN;
+        cab.tam_registro = sizeof(RegistroGeob);
+        cab.n_formas = (uint64_t) n_gravadas;
+        cab.n_estilos = (uint64_t) n_estilos;
+        cab.tam_strings = strings.tamanho;
+        cab.soma_dados = soma;
+        cab.soma_cabecalho = 0;
+        cab.soma_cabecalho = soma_atualiza(SOMA_INICIAL, &cab, sizeof(cab));
+        ok = fseek(f, 0, SEEK_SET) == 0 && fwrite(&cab, sizeof(cab), 1, f) == 1;
+    }
+    
+    if (fclose(f) != 0) {
+        ok = 0;
+    }
+    if (!ok) {
+        printf("Erro ao gravar o arquivo %s\n", caminho);
+        remove(caminho);
+    }
+    
+    if (strings.dados != NULL) {
+        bloco_libera(&strings);
+    }
+    free(estilos);
+    free(array);
+    return ok;
+}
+
+/*==========================*/
+/* Carregamento             */
+/*==========================*/
+
+static int cabecalho_valido(const CabecalhoGeob* cab, size_t tamanho_arquivo) {
+    if (memcmp(cab->magica, "GEOB", 4) != 0) {
+        printf("Erro: arquivo nao e um geob\n");
+        return 0;
+    }
+    if (cab->marca_endian != GEOB_MARCA_ENDIAN) {
+        printf("Erro: geob gravado em maquina com outra ordem de bytes\n");
+        return 0;
+    }
+    if (cab->versao != GEOB_VERSAO || cab->tam_registro != sizeof(RegistroGeob)) {
+        printf("Erro: versao %u do geob nao suportada (esperada %d)\n", cab->versao, GEOB_VERSAO);
+        return 0;
+    }
+    
+    CabecalhoGeob copia = *cab;
+    copia.soma_cabecalho = 0;
+    if (soma_atualiza(SOMA_INICIAL, &copia, sizeof(copia)) != cab->soma_cabecalho) {
+        printf("Erro: cabecalho do geob corrompido\n");
+        return 0;
+    }
+    
+    // Os tamanhos declarados têm que fechar exatamente com o arquivo. Cada parte é
+    // descontada do que resta antes de checar a próxima, para a soma não transbordar.
+    uint64_t restante = tamanho_arquivo - sizeof(CabecalhoGeob);
+    int consistente = cab->n_formas <= INT32_MAX && cab->n_formas <= restante / sizeof(RegistroGeob);
+    if (consistente) {
+        restante -= cab->n_formas * sizeof(RegistroGeob);
+        consistente = cab->n_estilos <= restante / sizeof(RegistroEstilo);
+    }
+    if (consistente) {
+        restante -= cab->n_estilos * sizeof(RegistroEstilo);
+        consistente = cab->tam_strings == restante && cab->tam_strings != 0 && cab->tam_strings % 8 == 0;
+    }
+    if (!consistente) {
+        printf("Erro: tamanho do geob inconsistente\n");
+        return 0;
+    }
+    return 1;
+}
+
+// Strings referenciadas precisam estar dentro do bloco (que termina em '\0')
+static int deslocamento_valido(uint32_t off, uint64_t tam_strings) {
+    return off < tam_strings;
+}
+
+Lista geob_carrega(const char* caminho) {
+    ArquivoMapeado arquivo = arquivo_mapeia(caminho);
+    if (arquivo == NULL) {
+        printf("erro ao abrir arquivo geob\n");
+        return NULL;
+    }
+    
+    const char* dados = arquivo_dados(arquivo);
+    size_t tamanho = arquivo_tamanho(arquivo);
+    
+    CabecalhoGeob cab;
+    if (tamanho < sizeof(cab)) {
+        printf("Erro: arquivo geob truncado\n");
+        arquivo_libera(arquivo);
+        return NULL;
+    }
+    memcpy(&cab, dados, sizeof(cab));
+    if (!cabecalho_valido(&cab, tamanho)) {
+        arquivo_libera(arquivo);
+        return NULL;
+    }
+    
+    const char* corpo = dados + sizeof(CabecalhoGeob);
+    if (soma_atualiza(SOMA_INICIAL, corpo, tamanho - sizeof(CabecalhoGeob)) != cab.soma_dados) {
+        printf("Erro: dados do geob corrompidos\n");
+        arquivo_libera(arquivo);
+        return NULL;
+    }
+    
+    // O mmap é alinhado à página e todos os blocos têm tamanho múltiplo de 8
+    const RegistroGeob* regs = (const RegistroGeob*) corpo;
+    const RegistroEstilo* estilos = (const RegistroEstilo*) (corpo + cab.n_formas * sizeof(RegistroGeob));
+    const char* strings = (const char*) (estilos + cab.n_estilos);
+    
+    if (strings[cab.tam_strings - 1] != '\0') {
+        printf("Erro: bloco de strings do geob invalido\n");
+        arquivo_libera(arquivo);
+        return NULL;
+    }
+    for (uint64_t i = 0; i < cab.n_estilos; i++) {
+        if (!deslocamento_valido(estilos[i].family, cab.tam_strings) ||
+            !deslocamento_valido(estilos[i].weight, cab.tam_strings)) {
+            printf("Erro: estilo invalido no geob\n");
+            arquivo_libera(arquivo);
+            return NULL;
+        }
+    }
+    
+    Lista formas = lista_cria();
+    // Um Estilo compartilhado por registro de estilo, criado no primeiro texto que o usa
+    Estilo* estilos_carregados = (Estilo*) calloc(cab.n_estilos > 0 ? cab.n_estilos : 1, sizeof(Estilo));
+    if (formas == NULL || estilos_carregados == NULL) {
+        printf("Erro ao alocar memoria em geob_carrega\n");
+        if (formas != NULL) lista_destruir(formas);
+        free(estilos_carregados);
+        arquivo_libera(arquivo);
+        return NULL;
+    }
+    
+    for (uint64_t i = 0; i < cab.n_formas; i++) {
+        const RegistroGeob* r = &regs[i];
+        if (!deslocamento_valido(r->corb, cab.tam_strings) ||
+            !deslocamento_valido(r->corp, cab.tam_strings) ||
+            !deslocamento_valido(r->txto, cab.tam_strings) ||
+            r->estilo >= (int64_t) cab.n_estilos || r->estilo < GEOB_SEM_ESTILO) {
+            printf("Erro: forma %d invalida no geob\n", r->id);
+            continue;
+        }
+        
+        // Os construtores copiam as strings, então elas podem apontar para o mapeamento
+        char* corb = (char*) strings + r->corb;
+        char* corp = (char*) strings + r->corp;
+        Forma f = NULL;
+        
+        switch (r->tipo) {
+            case 'c':
+                f = circulo_cria(r->id, r->v[0], r->v[1], r->v[2], corb, corp);
+                break;
+            case 'r':
+                f = retangulo_cria(r->id, r->v[0], r->v[1], r->v[2], r->v[3], corb, corp);
+                break;
+            case 'l':
+                f = linha_cria(r->id, r->v[0], r->v[1], r->v[2], r->v[3], corb);
+                break;
+            case 't': {
+                Estilo estilo = NULL;
+                if (r->estilo != GEOB_SEM_ESTILO) {
+                    if (estilos_carregados[r->estilo] == NULL) {
+                        const RegistroEstilo* e = &estilos[r->estilo];
+                        estilos_carregados[r->estilo] = estilo_interna((char*) strings + e->family,
+                                                                       (char*) strings + e->weight, e->size);
+                    }
+                    estilo = estilo_referencia(estilos_carregados[r->estilo]);
+                }
+                f = texto_cria(r->id, r->v[0], r->v[1], corb, corp, (char) r->a, (char*) strings + r->txto, estilo);
+                break;
+            }
+            default:
+                printf("Erro: tipo de forma desconhecido no geob\n");
+                break;
+        }
+        
+        if (f != NULL) {
+            lista_adiciona(formas, f);
+        }
+    }
+    
+    for (uint64_t i = 0; i < cab.n_estilos; i++) {
+        estilo_destroi(estilos_carregados[i]);
+    }
+    free(estilos_carregados);
+    arquivo_libera(arquivo);
+    return formas;
+}
+
+int geob_eh_arquivo_geob(const char* caminho) {
+    if (caminho == NULL) {
+        return 0;
+    }
+    size_t len = strlen(caminho);
+    return len >= 5 && strcmp(caminho + len - 5, ".geob") == 0;
+}
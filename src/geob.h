@@ -0,0 +1,42 @@
+#ifndef GEOB_H
+#define GEOB_H
+
+#include "lista.h"
+
+/*
+* Formato binário de cena (.geob).
+* Guarda as formas já interpretadas de um .geo: registros de tamanho fixo, a tabela de
+* estilos de texto e um bloco de strings sem repetição (cores se repetem muito).
+* O arquivo tem número de versão, marca de endianness e somas de verificação do
+* cabeçalho e dos dados; é carregado via mmap, sem nenhuma interpretação de texto.
+* Gerado por 'ted --compile-geo'.
+*/
+
+/*
+* Versão atual do formato. Arquivos de outra versão são recusados.
+*/
+#define GEOB_VERSAO 1
+
+/**
+ * @brief Grava uma lista de formas no formato .geob.
+ * @param formas A lista de formas (como retornada por processaGeo).
+ * @param caminho Caminho do arquivo a ser criado.
+ * @return int 1 em caso de sucesso, 0 em caso de erro.
+ */
+int geob_grava(Lista formas, const char* caminho);
+
+/**
+ * @brief Carrega um arquivo .geob e recria a lista de formas.
+ * Verifica versão, endianness, limites e somas de verificação antes de criar as formas.
+ * @param caminho Caminho do arquivo .geob.
+ * @return Lista A lista de formas, ou NULL se o arquivo for inválido.
+ */
+Lista geob_carrega(const char* caminho);
+
+/**
+ * @brief Verifica se o caminho tem a extensão .geob.
+ * @return int 1 se for um .geob, 0 caso contrário.
+ */
+int geob_eh_arquivo_geob(const char* caminho);
+
+#endif
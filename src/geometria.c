@@ -38,12 +38,6 @@ double geometria_distancia_ponto_segmento(double px, double py, double x1, doubl
     return sqrt(dx * dx + dy * dy);
 }
 
-double geometria_distancia_ponto_anteparo(double px, double py, Anteparo a) {
-    double x1, y1, x2, y2;
-    anteparo_getCoordenadas(a, &x1, &y1, &x2, &y2);
-    return geometria_distancia_ponto_segmento(px, py, x1, y1, x2, y2);
-}
-
 double geometria_orientacao(double x1, double y1, double x2, double y2, double x3, double y3) {
     return (x2 - x1) * (y3 - y1) - (y2 - y1) * (x3 - x1);
 }
@@ -105,13 +99,6 @@ int geometria_raio_intersecta_segmento(double px, double py, double dx, double d
     return 0;
 }
 
-int geometria_raio_intersecta_anteparo(double px, double py, double dx, double dy, 
-                                        Anteparo a, double* ix, double* iy) {
-    double x1, y1, x2, y2;
-    anteparo_getCoordenadas(a, &x1, &y1, &x2, &y2);
-    return geometria_raio_intersecta_segmento(px, py, dx, dy, x1, y1, x2, y2, ix, iy);
-}
-
 double geometria_calcula_angulo(double x_ref, double y_ref, double px, double py) {
     double dx = px - x_ref;
     double dy = py - y_ref;
@@ -1,7 +1,6 @@
 #ifndef GEOMETRIA_H
 #define GEOMETRIA_H
 
-#include "anteparo.h"
 #include <stdbool.h>
 
 /*
@@ -37,16 +36,6 @@ double geometria_distancia_pontos(double x1, double y1, double x2, double y2);
  */
 double geometria_distancia_ponto_segmento(double px, double py, double x1, double y1, double x2, double y2);
 
-/**
- * @brief Calcula a distância de um ponto a um anteparo existente.
- * Wrapper para a função de distância ponto-segmento usando o TAD Anteparo.
- * @param px X do ponto.
- * @param py Y do ponto.
- * @param a O anteparo alvo.
- * @return double A distância calculada.
- */
-double geometria_distancia_ponto_anteparo(double px, double py, Anteparo a);
-
 /*=============================*/
 /* Orientação e Posição        */
 /*=============================*/
@@ -102,18 +91,6 @@ int geometria_raio_intersecta_segmento(double px, double py, double dx, double d
                                        double x1, double y1, double x2, double y2, 
                                        double* ix, double* iy);
 
-/**
- * @brief Wrapper para calcular interseção de raio com um Anteparo.
- * Fundamental para o algoritmo de visibilidade (descobrir qual anteparo o raio atinge primeiro).
- * @param px, py Origem da bomba/luz.
- * @param dx, dy Vetor direção do raio.
- * @param a O anteparo a ser testado.
- * @param ix [out] Ponteiro para X da interseção.
- * @param iy [out] Ponteiro para Y da interseção.
- * @return int 1 se intersecta, 0 caso contrário.
- */
-int geometria_raio_intersecta_anteparo(double px, double py, double dx, double dy, Anteparo a, double* ix, double* iy);
-
 /**
  * @brief Calcula o angulo entre 2 pontos.
  * @param x_ref a coord x do primeiro ponto.
@@ -0,0 +1,369 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "leitor.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Maior campo numérico repassado ao strtod no caminho lento.
+#define TAM_MAX_NUMERO 128
+// Potências de 10 representáveis exatamente em double.
+#define MAX_POTENCIA_EXATA 22
+// Maior mantissa representável exatamente em double (2^53).
+#define MAX_MANTISSA_EXATA 9007199254740992ULL
+
+typedef struct {
+    char* dados;
+    size_t tamanho;
+    int mapeado;             // 1 se veio de mmap, 0 se foi lido para um buffer
+} EstruturaArquivo;
+
+static const double potencias_10[MAX_POTENCIA_EXATA + 1] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/*==========================*/
+/* Arquivo Mapeado          */
+/*==========================*/
+
+// Lê o arquivo inteiro para um buffer (quando não dá para mapear)
+static int le_para_buffer(int fd, EstruturaArquivo* arq) {
+    size_t capacidade = 1 << 16;
+    size_t usado = 0;
+    char* dados = (char*)malloc(capacidade);
+    if (dados == NULL) {
+        return 0;
+    }
+    
+    for (;;) {
+        if (usado == capacidade) {
+            char* novo = (char*)realloc(dados, capacidade * 2);
+            if (novo == NULL) {
+                free(dados);
+                return 0;
+            }
+            dados = novo;
+            capacidade *= 2;
+        }
+        ssize_t lidos = read(fd, dados + usado, capacidade - usado);
+        if (lidos < 0) {
+            free(dados);
+            return 0;
+        }
+        if (lidos == 0) {
+            break;
+        }
+        usado += (size_t)lidos;
+    }
+    
+    arq->dados = dados;
+    arq->tamanho = usado;
+    arq->mapeado = 0;
+    return 1;
+}
+
+ArquivoMapeado arquivo_mapeia(const char* caminho) {
+    int fd = open(caminho, O_RDONLY);
+    if (fd < 0) {
+        return NULL;
+    }
+    
+    EstruturaArquivo* arq = (EstruturaArquivo*)malloc(sizeof(EstruturaArquivo));
+    if (arq == NULL) {
+        printf("Erro ao alocar arquivo mapeado\n");
+        close(fd);
+        return NULL;
+    }
+    arq->dados = NULL;
+    arq->tamanho = 0;
+    arq->mapeado = 0;
+    
+    struct stat info;
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode)) {
+        arq->tamanho = (size_t)info.st_size;
+        if (arq->tamanho == 0) {
+            close(fd);
+            return (ArquivoMapeado)arq;
+        }
+        void* mapa = mmap(NULL, arq->tamanho, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapa != MAP_FAILED) {
+            posix_madvise(mapa, arq->tamanho, POSIX_MADV_SEQUENTIAL);
+            arq->dados = (char*)mapa;
+            arq->mapeado = 1;
+            close(fd);
+            return (ArquivoMapeado)arq;
+        }
+    }
+    
+    if (!le_para_buffer(fd, arq)) {
+        printf("Erro ao ler o arquivo %s\n", caminho);
+        free(arq);
+        close(fd);
+        return NULL;
+    }
+    
+    close(fd);
+    return (ArquivoMapeado)arq;
+}
+
+const char* arquivo_dados(ArquivoMapeado arquivo) {
+    EstruturaArquivo* arq = (EstruturaArquivo*)arquivo;
+    return arq != NULL ? arq->dados : NULL;
+}
+
+size_t arquivo_tamanho(ArquivoMapeado arquivo) {
+    EstruturaArquivo* arq = (EstruturaArquivo*)arquivo;
+    return arq != NULL ? arq->tamanho : 0;
+}
+
+void arquivo_libera(ArquivoMapeado arquivo) {
+    EstruturaArquivo* arq = (EstruturaArquivo*)arquivo;
+    if (arq == NULL) {
+        return;
+    }
+    
+    if (arq->mapeado) {
+        munmap(arq->dados, arq->tamanho);
+    } else {
+        free(arq->dados);
+    }
+    free(arq);
+}
+
+/*==========================*/
+/* Cursor de Texto          */
+/*==========================*/
+
+static int eh_espaco(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+static int eh_digito(char c) {
+    return c >= '0' && c <= '9';
+}
+
+// Valor de um dígito na base (ou -1 se não for dígito válido)
+static int valor_digito(char c, int base) {
+    int v;
+    if (c >= '0' && c <= '9') v = c - '0';
+    else if (c >= 'a' && c <= 'f') v = c - 'a' + 10;
+    else if (c >= 'A' && c <= 'F') v = c - 'A' + 10;
+    else return -1;
+    return v < base ? v : -1;
+}
+
+void cursor_inicia(CursorTexto* cursor, const char* dados, size_t tamanho) {
+    cursor->p = dados;
+    cursor->fim = dados + tamanho;
+}
+
+int cursor_proxima_linha(CursorTexto* cursor, CursorTexto* linha) {
+    if (cursor->p >= cursor->fim) {
+        return 0;
+    }
+    
+    const char* fim_linha = memchr(cursor->p, '\n', (size_t)(cursor->fim - cursor->p));
+    if (fim_linha == NULL) {
+        fim_linha = cursor->fim;
+    }
+    
+    linha->p = cursor->p;
+    linha->fim = fim_linha;
+    cursor->p = fim_linha < cursor->fim ? fim_linha + 1 : fim_linha;
+    return 1;
+}
+
+void cursor_pula_espacos(CursorTexto* cursor) {
+    while (cursor->p < cursor->fim && eh_espaco(*cursor->p)) {
+        cursor->p++;
+    }
+}
+
+int cursor_le_palavra(CursorTexto* cursor, char* destino, int tamanho) {
+    cursor_pula_espacos(cursor);
+    if (cursor->p >= cursor->fim) {
+        return 0;
+    }
+    
+    int n = 0;
+    while (cursor->p < cursor->fim && !eh_espaco(*cursor->p)) {
+        if (n < tamanho - 1) {
+            destino[n++] = *cursor->p;
+        }
+        cursor->p++;
+    }
+    destino[n] = '\0';
+    return 1;
+}
+
+int cursor_le_char(CursorTexto* cursor, char* valor) {
+    cursor_pula_espacos(cursor);
+    if (cursor->p >= cursor->fim) {
+        return 0;
+    }
+    *valor = *cursor->p++;
+    return 1;
+}
+
+// Lê um inteiro na base dada (0 detecta a base como o strtol)
+static int le_inteiro(CursorTexto* cursor, int* valor, int base) {
+    cursor_pula_espacos(cursor);
+    const char* p = cursor->p;
+    const char* fim = cursor->fim;
+    
+    int negativo = 0;
+    if (p < fim && (*p == '+' || *p == '-')) {
+        negativo = *p == '-';
+        p++;
+    }
+    if (p >= fim || !eh_digito(*p)) {
+        return 0;
+    }
+    
+    // Mesma detecção de base do strtol com base 0
+    if (base == 0 && *p != '0') {
+        base = 10;
+    } else if (base == 0) {
+        base = 8;
+        if (p + 2 < fim && (p[1] == 'x' || p[1] == 'X') && valor_digito(p[2], 16) >= 0) {
+            base = 16;
+            p += 2;
+        }
+    }
+    
+    // Acumula em módulo; fora do intervalo de long, strtol satura e o scanf trunca para int
+    unsigned long long acumulado = 0;
+    int estourou = 0;
+    int d;
+    while (p < fim && (d = valor_digito(*p, base)) >= 0) {
+        if (acumulado > ((unsigned long long)LONG_MAX + 1 - (unsigned)d) / (unsigned)base) {
+            estourou = 1;
+        } else {
+            acumulado = acumulado * base + d;
+        }
+        p++;
+    }
+    
+    long resultado;
+    if (negativo) {
+        resultado = (estourou || acumulado > (unsigned long long)LONG_MAX + 1) ? LONG_MIN : (long)(0 - acumulado);
+    } else {
+        resultado = (estourou || acumulado > (unsigned long long)LONG_MAX) ? LONG_MAX : (long)acumulado;
+    }
+    *valor = (int)resultado;
+    cursor->p = p;
+    return 1;
+}
+
+int cursor_le_int(CursorTexto* cursor, int* valor) {
+    return le_inteiro(cursor, valor, 0);
+}
+
+int cursor_le_decimal(CursorTexto* cursor, int* valor) {
+    return le_inteiro(cursor, valor, 10);
+}
+
+// Caminho lento: copia o campo e usa strtod
+static int le_double_strtod(CursorTexto* cursor, double* valor) {
+    char buffer[TAM_MAX_NUMERO];
+    int n = 0;
+    const char* p = cursor->p;
+    while (p < cursor->fim && !eh_espaco(*p) && n < TAM_MAX_NUMERO - 1) {
+        buffer[n++] = *p++;
+    }
+    buffer[n] = '\0';
+    
+    char* fim_numero;
+    double v = strtod(buffer, &fim_numero);
+    if (fim_numero == buffer) {
+        return 0;
+    }
+    
+    *valor = v;
+    cursor->p += fim_numero - buffer;
+    return 1;
+}
+
+int cursor_le_double(CursorTexto* cursor, double* valor) {
+    cursor_pula_espacos(cursor);
+    const char* p = cursor->p;
+    const char* fim = cursor->fim;
+    
+    int negativo = 0;
+    if (p < fim && (*p == '+' || *p == '-')) {
+        negativo = *p == '-';
+        p++;
+    }
+    
+    uint64_t mantissa = 0;
+    int digitos = 0;         // Dígitos acumulados na mantissa
+    int expoente = 0;
+    int viu_digito = 0;
+    
+    while (p < fim && eh_digito(*p)) {
+        mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+        digitos++;
+        viu_digito = 1;
+        p++;
+    }
+    // "0x..." é hexadecimal: fica com o strtod
+    if (p < fim && (*p == 'x' || *p == 'X')) {
+        return le_double_strtod(cursor, valor);
+    }
+    if (p < fim && *p == '.') {
+        p++;
+        while (p < fim && eh_digito(*p)) {
+            mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+            digitos++;
+            expoente--;
+            viu_digito = 1;
+            p++;
+        }
+    }
+    if (!viu_digito) {
+        // inf, nan ou não é número
+        return le_double_strtod(cursor, valor);
+    }
+    if (p < fim && (*p == 'e' || *p == 'E')) {
+        const char* q = p + 1;
+        int exp_negativo = 0;
+        if (q < fim && (*q == '+' || *q == '-')) {
+            exp_negativo = *q == '-';
+            q++;
+        }
+        // Sem dígitos depois do 'e', o expoente não faz parte do número
+        if (q < fim && eh_digito(*q)) {
+            int e = 0;
+            while (q < fim && eh_digito(*q)) {
+                if (e < 100000) e = e * 10 + (*q - '0');
+                q++;
+            }
+            expoente += exp_negativo ? -e : e;
+            p = q;
+        }
+    }
+    
+    // Fora do caminho exato (mantissa e potência de 10 exatas em double): strtod
+    if (digitos > 19 || mantissa > MAX_MANTISSA_EXATA ||
+        expoente > MAX_POTENCIA_EXATA || expoente < -MAX_POTENCIA_EXATA) {
+        return le_double_strtod(cursor, valor);
+    }
+    
+    double v = (double)mantissa;
+    if (expoente < 0) {
+        v /= potencias_10[-expoente];
+    } else {
+        v *= potencias_10[expoente];
+    }
+    
+    *valor = negativo ? -v : v;
+    cursor->p = p;
+    return 1;
+}
@@ -0,0 +1,110 @@
+#ifndef LEITOR_H
+#define LEITOR_H
+
+#include <stddef.h>
+
+/*
+* Módulo de Leitura Rápida de Arquivos Texto.
+* Mapeia o arquivo inteiro em memória (mmap) e o percorre no próprio lugar, sem cópias
+* nem limite de tamanho de linha. Os números são lidos por um scanner próprio, com o
+* mesmo resultado de strtod/strtol, mas sem o custo de sscanf a cada campo.
+* Usado na leitura do .geo, cujos arquivos podem ter vários GB.
+*/
+
+/*
+* Declaração opaca do arquivo mapeado.
+*/
+typedef void* ArquivoMapeado;
+
+/*
+* Cursor sobre um trecho de texto [p, fim). Não é opaco para poder ficar na pilha
+* no laço de leitura; os campos só devem ser alterados pelas funções abaixo.
+*/
+typedef struct {
+    const char* p;
+    const char* fim;
+} CursorTexto;
+
+/*==========================*/
+/* Arquivo Mapeado          */
+/*==========================*/
+/**
+ * @brief Mapeia um arquivo em memória, somente leitura.
+ * Se o mmap não for possível (ex: pipe), o conteúdo é lido para um buffer alocado.
+ * @param caminho Caminho do arquivo.
+ * @return ArquivoMapeado O arquivo mapeado, ou NULL em caso de erro.
+ */
+ArquivoMapeado arquivo_mapeia(const char* caminho);
+
+/**
+ * @brief Retorna o início do conteúdo do arquivo (não terminado em '\0').
+ */
+const char* arquivo_dados(ArquivoMapeado arquivo);
+
+/**
+ * @brief Retorna o tamanho do conteúdo em bytes.
+ */
+size_t arquivo_tamanho(ArquivoMapeado arquivo);
+
+/**
+ * @brief Desfaz o mapeamento e libera o arquivo. Cursores sobre ele deixam de ser válidos.
+ */
+void arquivo_libera(ArquivoMapeado arquivo);
+
+/*==========================*/
+/* Cursor de Texto          */
+/*==========================*/
+/**
+ * @brief Posiciona o cursor no início de um trecho de texto.
+ */
+void cursor_inicia(CursorTexto* cursor, const char* dados, size_t tamanho);
+
+/**
+ * @brief Extrai a próxima linha (sem o '\n') e avança o cursor para a seguinte.
+ * @param cursor Cursor sobre o texto inteiro.
+ * @param linha Recebe um cursor sobre a linha extraída.
+ * @return int 1 se uma linha foi extraída, 0 no fim do texto.
+ */
+int cursor_proxima_linha(CursorTexto* cursor, CursorTexto* linha);
+
+/**
+ * @brief Avança sobre espaços em branco (como isspace).
+ */
+void cursor_pula_espacos(CursorTexto* cursor);
+
+/**
+ * @brief Lê a próxima palavra (sequência sem espaços), como o "%s" do scanf.
+ * Palavras maiores que o destino são truncadas, mas consumidas por inteiro.
+ * @param destino Buffer que recebe a palavra terminada em '\0'.
+ * @param tamanho Tamanho do buffer destino.
+ * @return int 1 se uma palavra foi lida, 0 se não havia mais nada.
+ */
+int cursor_le_palavra(CursorTexto* cursor, char* destino, int tamanho);
+
+/**
+ * @brief Lê o próximo caractere que não seja espaço, como o " %c" do scanf.
+ * @return int 1 se leu, 0 se não havia mais nada.
+ */
+int cursor_le_char(CursorTexto* cursor, char* valor);
+
+/**
+ * @brief Lê um inteiro como o "%i" do scanf (decimal, 0x hexadecimal ou 0 octal).
+ * @return int 1 se leu, 0 se o próximo campo não é um inteiro (o cursor não avança).
+ */
+int cursor_le_int(CursorTexto* cursor, int* valor);
+
+/**
+ * @brief Lê um inteiro decimal como o "%d" do scanf.
+ * @return int 1 se leu, 0 se o próximo campo não é um inteiro (o cursor não avança).
+ */
+int cursor_le_decimal(CursorTexto* cursor, int* valor);
+
+/**
+ * @brief Lê um double como o "%lf" do scanf, com o mesmo arredondamento de strtod.
+ * Casos comuns (até 19 dígitos e expoente pequeno) são convertidos diretamente;
+ * os demais (hexadecimal, inf, nan, muitos dígitos) caem para strtod.
+ * @return int 1 se leu, 0 se o próximo campo não é um número (o cursor não avança).
+ */
+int cursor_le_double(CursorTexto* cursor, double* valor);
+
+#endif
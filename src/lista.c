@@ -64,6 +64,32 @@ void lista_adiciona(Lista l, void* elemento) {
     return;
 }
 
+void lista_concatena(Lista d, Lista o) {
+    EstruturaLista *destino = (EstruturaLista*) d;
+    EstruturaLista *origem = (EstruturaLista*) o;
+
+    if (destino == NULL || origem == NULL) {
+        printf("erro ao concatenar, lista nao criada\n");
+        return;
+    }
+
+    if (origem->tamanho == 0 || destino == origem) {
+        return;
+    }
+
+    if (destino->tamanho == 0) {
+        destino->inicio = origem->inicio;
+    } else {
+        destino->fim->prox = origem->inicio;
+    }
+    destino->fim = origem->fim;
+    destino->tamanho += origem->tamanho;
+
+    origem->inicio = NULL;
+    origem->fim = NULL;
+    origem->tamanho = 0;
+}
+
 void* lista_retira(Lista l, void* e) {
     EstruturaLista* lista = (EstruturaLista*) l;
     if (lista == NULL) {
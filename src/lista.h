@@ -34,6 +34,14 @@ Lista lista_cria();
  */
 void lista_adiciona(Lista l, void* e);
 
+/**
+ * @brief Move todos os elementos de 'origem' para o final de 'destino', em O(1).
+ * A lista origem fica vazia (mas continua válida e deve ser destruída pelo chamador).
+ * @param destino A lista que recebe os elementos.
+ * @param origem A lista cujos elementos são movidos.
+ */
+void lista_concatena(Lista destino, Lista origem);
+
 /*==========================*/
 /* Operações de Remoção     */
 /*==========================*/
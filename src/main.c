@@ -1,9 +1,15 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdarg.h>
 #include "lista.h"
 #include "formas.h"
 #include "svg.h"
+#include "geob.h"
+#include "saida.h"
+#include "estilo.h"
+#include "cores.h"
+#include "estatisticas.h"
 
 #define PATH_LEN 500
 #define FILE_NAME_LEN 200
@@ -11,13 +17,68 @@
 // Declarações das funções (protótipos)
 Lista processaGeo(const char *path_geo);
 void processaQry(const char *path_qry, Lista formas, 
-                 const char *path_svg_saida, const char *path_txt_saida);
+                 const char *path_svg_saida, const char *path_txt_saida,
+                 int svg_comprimido, int txt_comprimido, Estatisticas est);
+
+/*
+* Monta um caminho de saída em 'destino' (PATH_LEN bytes) com formato de printf.
+* Retorna 1 em caso de sucesso, ou 0 (com aviso) se o caminho não couber.
+*/
+static int monta_caminho(char* destino, const char* formato, ...) {
+    va_list args;
+    va_start(args, formato);
+    int n = vsnprintf(destino, PATH_LEN, formato, args);
+    va_end(args);
+    if (n < 0 || n >= PATH_LEN) {
+        printf("Erro: caminho de saída com mais de %d caracteres\n", PATH_LEN - 1);
+        return 0;
+    }
+    return 1;
+}
+
+/*
+* Libera a cena inteira de uma vez: as formas estão na arena da cena, então não é
+* preciso destruir uma por uma.
+*/
+static void libera_cena(Lista formas) {
+    lista_destruir(formas);
+    formas_libera_cena();
+    estilo_libera_todos();
+    cores_libera();
+}
+
+/*
+* --stats: fecha o registro da leitura do .geo (e do svg inicial ou do .geob gravado).
+*/
+static void fecha_registro_geo(Estatisticas est, Lista formas) {
+    if (est == NULL) return;
+    long long alocacoes;
+    formas_uso_cena(&alocacoes, NULL);
+    estatisticas_marca(est, FASE_SAIDA);
+    estatisticas_soma(est, CONT_ALOCACOES, alocacoes);
+    estatisticas_fecha_registro(est, lista_tamanho(formas));
+}
+
+/*
+* --stats: grava as estatísticas em CSV ao lado do relatório e as libera.
+*/
+static void grava_estatisticas(Estatisticas est, const char* caminho) {
+    if (est == NULL) return;
+    if (estatisticas_grava_csv(est, caminho)) {
+        printf("Estatísticas gravadas em %s\n", caminho);
+    }
+    estatisticas_destroi(est);
+}
 
 int main(int argc, char* argv[]) {
     char dir_entrada[PATH_LEN] = ".";
     char dir_saida[PATH_LEN] = ".";
     char arquivo_geo[FILE_NAME_LEN] = "";
     char arquivo_qry[FILE_NAME_LEN] = "";
+    int compila_geo = 0;
+    int svgz = 0;
+    int txtgz = 0;
+    int stats = 0;
     
     // Parse argumentos
     for (int i = 1; i < argc; i++) {
@@ -39,6 +100,18 @@ int main(int argc, char* argv[]) {
         else if (strcmp(argv[i], "-q") == 0 && i+1 < argc) {
             strncpy(arquivo_qry, argv[++i], FILE_NAME_LEN - 1);
         }
+        else if (strcmp(argv[i], "--compile-geo") == 0) {
+            compila_geo = 1;
+        }
+        else if (strcmp(argv[i], "--svgz") == 0) {
+            svgz = 1;
+        }
+        else if (strcmp(argv[i], "--txtgz") == 0) {
+            txtgz = 1;
+        }
+        else if (strcmp(argv[i], "--stats") == 0) {
+            stats = 1;
+        }
     }
     
     if (strlen(arquivo_geo) == 0) {
@@ -46,6 +119,11 @@ int main(int argc, char* argv[]) {
         return 1;
     }
     
+    if ((svgz || txtgz) && !saida_compressao_disponivel()) {
+        printf("Erro: --svgz/--txtgz exigem compilação com zlib\n");
+        return 1;
+    }
+    
     // Monta caminhos
     char caminho_geo[PATH_LEN];
     snprintf(caminho_geo, PATH_LEN, "%s/%s", dir_entrada, arquivo_geo);
@@ -60,18 +138,52 @@ int main(int argc, char* argv[]) {
     char* ponto = strrchr(nome_base, '.');
     if (ponto != NULL) *ponto = '\0';
     
-    // Processa .geo
-    Lista formas = processaGeo(caminho_geo);
+    Estatisticas est = stats ? estatisticas_cria() : NULL;
+    estatisticas_abre_registro(est, "geo", -1);
+    
+    // Processa .geo (ou carrega a cena já compilada de um .geob)
+    Lista formas = geob_eh_arquivo_geob(caminho_geo) ? geob_carrega(caminho_geo)
+                                                     : processaGeo(caminho_geo);
     
     if (formas == NULL) {
         printf("Erro ao processar arquivo .geo\n");
+        estatisticas_destroi(est);
         return 1;
     }
+    estatisticas_marca(est, FASE_LEITURA);
+    
+    // Estatísticas sem .qry ficam em <saida>/<nome>.stats.csv
+    char path_stats[PATH_LEN] = "";
+    if (est != NULL && !monta_caminho(path_stats, "%s/%s.stats.csv", dir_saida, nome_base)) {
+        estatisticas_destroi(est);
+        libera_cena(formas);
+        return 1;
+    }
+    
+    // --compile-geo: só grava a cena em <saida>/<nome>.geob
+    if (compila_geo) {
+        char path_geob[PATH_LEN];
+        int ok = monta_caminho(path_geob, "%s/%s.geob", dir_saida, nome_base) &&
+                 geob_grava(formas, path_geob);
+        if (ok) {
+            printf("Cena compilada em %s\n", path_geob);
+        }
+        
+        fecha_registro_geo(est, formas);
+        grava_estatisticas(est, path_stats);
+        
+        libera_cena(formas);
+        return ok ? 0 : 1;
+    }
     
     // Desenha SVG inicial
     char path_svg_geo[PATH_LEN];
-    snprintf(path_svg_geo, PATH_LEN, "%s/%s.svg", dir_saida, nome_base);
-    FILE* svg_geo = svg_inicia(path_svg_geo);
+    if (!monta_caminho(path_svg_geo, "%s/%s.%s", dir_saida, nome_base, svgz ? "svgz" : "svg")) {
+        estatisticas_destroi(est);
+        libera_cena(formas);
+        return 1;
+    }
+    EscritorSvg svg_geo = svg_inicia(path_svg_geo, svgz);
     
     if (svg_geo != NULL) {
         int n;
@@ -85,6 +197,7 @@ int main(int argc, char* argv[]) {
         }
         svg_finaliza(svg_geo);
     }
+    fecha_registro_geo(est, formas);
     
     // Processa .qry se fornecido
     if (strlen(arquivo_qry) > 0) {
@@ -104,27 +217,27 @@ int main(int argc, char* argv[]) {
         // Cria SVG de saída do .qry
         char path_svg_qry[PATH_LEN];
         char path_txt_qry[PATH_LEN];
-        snprintf(path_svg_qry, PATH_LEN, "%s/%s-%s.svg", dir_saida, nome_base, nome_qry);
-        snprintf(path_txt_qry, PATH_LEN, "%s/%s-%s.txt", dir_saida, nome_base, nome_qry);
+        if (!monta_caminho(path_svg_qry, "%s/%s-%s.%s", dir_saida, nome_base, nome_qry,
+                           svgz ? "svgz" : "svg") ||
+            !monta_caminho(path_txt_qry, "%s/%s-%s.%s", dir_saida, nome_base, nome_qry,
+                           txtgz ? "txt.gz" : "txt")) {
+            estatisticas_destroi(est);
+            libera_cena(formas);
+            return 1;
+        }
+        
+        if (est != NULL && !monta_caminho(path_stats, "%s/%s-%s.stats.csv", dir_saida, nome_base, nome_qry)) {
+            estatisticas_destroi(est);
+            libera_cena(formas);
+            return 1;
+        }
         
         // Processa comando .qry
-        processaQry(caminho_qry, formas, path_svg_qry, path_txt_qry);
+        processaQry(caminho_qry, formas, path_svg_qry, path_txt_qry, svgz, txtgz, est);
     }
     
-        if (formas != NULL) {
-        int n;
-        void** array = lista_para_array(formas, &n);
-        if (array != NULL) {
-            for (int i = 0; i < n; i++) {
-                Forma f = (Forma)array[i];
-                if (f != NULL) {
-                    forma_destroi(f);
-                }
-            }
-            free(array);
-        }
-        lista_destruir(formas);
-    }
+    grava_estatisticas(est, path_stats);
+    libera_cena(formas);
     
     return 0;
 }
\ No newline at end of file
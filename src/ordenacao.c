@@ -2,123 +2,1178 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <pthread.h>
+
+// Endereço do i-ésimo elemento de um array genérico.
+#define ELEM(arr, i, tam) ((char*)(arr) + (size_t)(i) * (tam))
+
+// Elementos até esse tamanho usam um temporário na pilha no insertion sort.
+#define TAM_TEMP_LOCAL 64
+
+// Abaixo desse número de elementos por thread, a versão paralela ordena de forma serial.
+#define MIN_ELEMENTOS_POR_THREAD 4096
 
 
 void ordena_qsort(void* array, int n, int tamanho_elemento, FuncaoComparacao compara) {
-    qsort(array, n, tamanho_elemento, compara);
+    ordena_pdqsort(array, n, tamanho_elemento, compara);
 }
 
 
-void ordena_insertionSort(void* array, int inicio, int fim, int tamanho_elemento, FuncaoComparacao compara) {
-    
-    // Alocar espaço temporário para um elemento
-    void* temp = malloc(tamanho_elemento);
-    if (temp == NULL) {
-        printf("Erro ao alocar memória no insertion_sort\n");
-        return;
-    }
-    
-    char* arr = (char*)array;  // Tratar como array de bytes
-    
+// Insertion sort em arr[inicio..fim] usando 'temp' (espaço para um elemento) como auxiliar.
+static void insertion_sort(char* arr, int inicio, int fim, int tamanho_elemento, FuncaoComparacao compara, void* temp) {
     for (int i = inicio + 1; i <= fim; i++) {
-        // Copiar elemento atual para temp
-        memcpy(temp, arr + i * tamanho_elemento, tamanho_elemento);
+        // Elemento já está no lugar: evita as cópias para temp
+        if (compara(ELEM(arr, i - 1, tamanho_elemento), ELEM(arr, i, tamanho_elemento)) <= 0) {
+            continue;
+        }
+        
+        memcpy(temp, ELEM(arr, i, tamanho_elemento), tamanho_elemento);
         
         int j = i - 1;
         
         // Mover elementos maiores para direita
-        while (j >= inicio && compara(arr + j * tamanho_elemento, temp) > 0) {
-            memcpy(arr + (j + 1) * tamanho_elemento, arr + j * tamanho_elemento, tamanho_elemento);
+        while (j >= inicio && compara(ELEM(arr, j, tamanho_elemento), temp) > 0) {
             j--;
         }
+        memmove(ELEM(arr, j + 2, tamanho_elemento), ELEM(arr, j + 1, tamanho_elemento),
+                (size_t)(i - j - 1) * tamanho_elemento);
         
         // Inserir temp na posição correta
-        memcpy(arr + (j + 1) * tamanho_elemento, temp, tamanho_elemento);
+        memcpy(ELEM(arr, j + 1, tamanho_elemento), temp, tamanho_elemento);
+    }
+}
+
+
+void ordena_insertion_sort(void* array, int inicio, int fim, int tamanho_elemento, FuncaoComparacao compara) {
+    if (array == NULL || compara == NULL || inicio >= fim) {
+        return;
+    }
+    
+    // Temporário na pilha para elementos pequenos; heap apenas para elementos grandes
+    char temp_local[TAM_TEMP_LOCAL];
+    void* temp = temp_local;
+    
+    if (tamanho_elemento > TAM_TEMP_LOCAL) {
+        temp = malloc(tamanho_elemento);
+        if (temp == NULL) {
+            printf("Erro ao alocar memória no insertion_sort\n");
+            return;
+        }
+    }
+    
+    insertion_sort((char*)array, inicio, fim, tamanho_elemento, compara, temp);
+    
+    if (temp != temp_local) {
+        free(temp);
+    }
+}
+
+
+/*==================================*/
+/* Pattern-Defeating QuickSort      */
+/*==================================*/
+
+// Menor limite do insertion sort aceito (a quebra de padrões precisa de subarrays de 8+).
+#define PDQ_LIMITE_INSERCAO_MIN 8
+// Acima disso o pivô é a pseudomediana de 9 (ninther) em vez da mediana de 3.
+#define PDQ_LIMITE_NINTHER 128
+// Movimentos permitidos no insertion sort parcial antes de desistir.
+#define PDQ_LIMITE_PARCIAL 8
+// Tamanho dos blocos de offsets da partição sem desvios.
+#define PDQ_BLOCO 64
+// Elementos até esse tamanho usam a partição sem desvios (BlockQuicksort).
+#define PDQ_TAM_SEM_DESVIO 16
+
+typedef struct {
+    int tam;
+    FuncaoComparacao compara;
+    int limite_insercao;     // Subarrays menores que isso vão para o insertion sort
+    char* pivo;              // Cópia do pivô durante a partição
+    char* troca;             // Temporário para trocas
+} EstadoPdq;
+
+static void pdq_troca(EstadoPdq* e, char* a, char* b) {
+    memcpy(e->troca, a, e->tam);
+    memcpy(a, b, e->tam);
+    memcpy(b, e->troca, e->tam);
+}
+
+// Número de elementos entre dois ponteiros.
+static int pdq_dist(EstadoPdq* e, char* inicio, char* fim) {
+    return (int)((fim - inicio) / e->tam);
+}
+
+static void pdq_ordena2(EstadoPdq* e, char* a, char* b) {
+    if (e->compara(b, a) < 0) pdq_troca(e, a, b);
+}
+
+static void pdq_ordena3(EstadoPdq* e, char* a, char* b, char* c) {
+    pdq_ordena2(e, a, b);
+    pdq_ordena2(e, b, c);
+    pdq_ordena2(e, a, b);
+}
+
+// Insertion sort em [inicio, fim). Se 'guardado' for falso, assume que *(inicio - 1)
+// é <= a todos os elementos e dispensa o teste de limite.
+static void pdq_insertion(EstadoPdq* e, char* inicio, char* fim, int guardado) {
+    int tam = e->tam;
+    if (inicio == fim) return;
+    
+    for (char* atual = inicio + tam; atual != fim; atual += tam) {
+        char* pos = atual;
+        if (e->compara(pos, pos - tam) < 0) {
+            memcpy(e->pivo, pos, tam);
+            do {
+                memcpy(pos, pos - tam, tam);
+                pos -= tam;
+            } while ((!guardado || pos != inicio) && e->compara(e->pivo, pos - tam) < 0);
+            memcpy(pos, e->pivo, tam);
+        }
     }
+}
+
+// Tenta ordenar [inicio, fim) com poucos movimentos. Retorna 0 se passar do limite.
+static int pdq_insertion_parcial(EstadoPdq* e, char* inicio, char* fim) {
+    int tam = e->tam;
+    int movimentos = 0;
+    if (inicio == fim) return 1;
     
-    free(temp);
+    for (char* atual = inicio + tam; atual != fim; atual += tam) {
+        char* pos = atual;
+        if (e->compara(pos, pos - tam) < 0) {
+            memcpy(e->pivo, pos, tam);
+            do {
+                memcpy(pos, pos - tam, tam);
+                pos -= tam;
+            } while (pos != inicio && e->compara(e->pivo, pos - tam) < 0);
+            memcpy(pos, e->pivo, tam);
+            movimentos += pdq_dist(e, pos, atual);
+        }
+        if (movimentos > PDQ_LIMITE_PARCIAL) return 0;
+    }
+    return 1;
 }
 
-static void merge(void* array, int inicio, int meio, int fim, int tamanho_elemento, FuncaoComparacao compara) {
+static void pdq_peneira(EstadoPdq* e, char* base, int raiz, int n) {
+    int tam = e->tam;
+    int filho;
+    while ((filho = 2 * raiz + 1) < n) {
+        if (filho + 1 < n && e->compara(ELEM(base, filho, tam), ELEM(base, filho + 1, tam)) < 0) filho++;
+        if (e->compara(ELEM(base, raiz, tam), ELEM(base, filho, tam)) >= 0) break;
+        pdq_troca(e, ELEM(base, raiz, tam), ELEM(base, filho, tam));
+        raiz = filho;
+    }
+}
+
+static void pdq_heapsort(EstadoPdq* e, char* inicio, char* fim) {
+    int n = pdq_dist(e, inicio, fim);
+    for (int i = n / 2 - 1; i >= 0; i--) pdq_peneira(e, inicio, i, n);
+    for (int i = n - 1; i > 0; i--) {
+        pdq_troca(e, inicio, ELEM(inicio, i, e->tam));
+        pdq_peneira(e, inicio, 0, i);
+    }
+}
+
+// Particiona em [< pivô][pivô][>= pivô], com o pivô em *inicio. Devolve a posição final do
+// pivô; 'ja_particionado' indica que nenhuma troca foi necessária.
+static char* pdq_particao_direita(EstadoPdq* e, char* inicio, char* fim, int* ja_particionado) {
+    int tam = e->tam;
+    char* pivo = e->pivo;
+    char* primeiro = inicio;
+    char* ultimo = fim;
     
-    int n1 = meio - inicio + 1;
-    int n2 = fim - meio;
+    memcpy(pivo, inicio, tam);
     
-    void* esq = malloc(n1 * tamanho_elemento);
-    void* dir = malloc(n2 * tamanho_elemento);
+    // A mediana escolhida garante um elemento >= pivô à direita, então esse laço para
+    do { primeiro += tam; } while (e->compara(primeiro, pivo) < 0);
     
-    if (esq == NULL || dir == NULL) {
-        printf("Erro ao alocar memória no merge\n");
-        free(esq);
-        free(dir);
-        return;
+    if (primeiro - tam == inicio) {
+        while (primeiro < ultimo && e->compara(ultimo -= tam, pivo) >= 0);
+    } else {
+        while (e->compara(ultimo -= tam, pivo) >= 0);
     }
     
-    char* arr = (char*)array;
+    *ja_particionado = primeiro >= ultimo;
+    
+    while (primeiro < ultimo) {
+        pdq_troca(e, primeiro, ultimo);
+        do { primeiro += tam; } while (e->compara(primeiro, pivo) < 0);
+        do { ultimo -= tam; } while (e->compara(ultimo, pivo) >= 0);
+    }
     
-    memcpy(esq, arr + inicio * tamanho_elemento, n1 * tamanho_elemento);
-    memcpy(dir, arr + (meio + 1) * tamanho_elemento, n2 * tamanho_elemento);
+    char* pos_pivo = primeiro - tam;
+    memcpy(inicio, pos_pivo, tam);
+    memcpy(pos_pivo, pivo, tam);
+    return pos_pivo;
+}
 
-    int i = 0, j = 0, k = inicio;
+// Mesmo contrato de pdq_particao_direita, mas as comparações apenas preenchem blocos de
+// offsets (sem desvios dependentes do resultado); as trocas são feitas depois, em lote.
+static char* pdq_particao_sem_desvio(EstadoPdq* e, char* inicio, char* fim, int* ja_particionado) {
+    int tam = e->tam;
+    char* pivo = e->pivo;
+    char* primeiro = inicio;
+    char* ultimo = fim;
+    
+    memcpy(pivo, inicio, tam);
+    
+    do { primeiro += tam; } while (e->compara(primeiro, pivo) < 0);
+    
+    if (primeiro - tam == inicio) {
+        while (primeiro < ultimo && e->compara(ultimo -= tam, pivo) >= 0);
+    } else {
+        while (e->compara(ultimo -= tam, pivo) >= 0);
+    }
+    
+    *ja_particionado = primeiro >= ultimo;
     
-    while (i < n1 && j < n2) {
-        char* elem_esq = (char*)esq + i * tamanho_elemento;
-        char* elem_dir = (char*)dir + j * tamanho_elemento;
+    if (!*ja_particionado) {
+        pdq_troca(e, primeiro, ultimo);
+        primeiro += tam;
         
-        if (compara(elem_esq, elem_dir) <= 0) {
-            memcpy(arr + k * tamanho_elemento, elem_esq, tamanho_elemento);
-            i++;
+        unsigned char offsets_esq[PDQ_BLOCO];
+        unsigned char offsets_dir[PDQ_BLOCO];
+        char* base_esq = primeiro;
+        char* base_dir = ultimo;
+        int n_esq = 0, n_dir = 0, ini_esq = 0, ini_dir = 0;
+        
+        while (primeiro < ultimo) {
+            // Quantos elementos cada lado examina nesta rodada
+            int desconhecidos = pdq_dist(e, primeiro, ultimo);
+            int parte_esq = (n_esq == 0) ? ((n_dir == 0) ? desconhecidos / 2 : desconhecidos) : 0;
+            int parte_dir = (n_dir == 0) ? (desconhecidos - parte_esq) : 0;
+            
+            if (parte_esq > PDQ_BLOCO) parte_esq = PDQ_BLOCO;
+            if (parte_dir > PDQ_BLOCO) parte_dir = PDQ_BLOCO;
+            
+            // Elementos >= pivô à esquerda e < pivô à direita estão do lado errado
+            for (int i = 0; i < parte_esq; i++) {
+                offsets_esq[n_esq] = (unsigned char)i;
+                n_esq += e->compara(primeiro, pivo) >= 0;
+                primeiro += tam;
+            }
+            for (int i = 0; i < parte_dir; i++) {
+                ultimo -= tam;
+                offsets_dir[n_dir] = (unsigned char)(i + 1);
+                n_dir += e->compara(ultimo, pivo) < 0;
+            }
+            
+            int num = (n_esq < n_dir) ? n_esq : n_dir;
+            for (int i = 0; i < num; i++) {
+                pdq_troca(e, base_esq + (size_t)offsets_esq[ini_esq + i] * tam,
+                             base_dir - (size_t)offsets_dir[ini_dir + i] * tam);
+            }
+            n_esq -= num;
+            n_dir -= num;
+            ini_esq += num;
+            ini_dir += num;
+            
+            if (n_esq == 0) {
+                ini_esq = 0;
+                base_esq = primeiro;
+            }
+            if (n_dir == 0) {
+                ini_dir = 0;
+                base_dir = ultimo;
+            }
+        }
+        
+        // Sobrou um lado com elementos pendentes: leva-os para a fronteira
+        if (n_esq) {
+            while (n_esq--) {
+                ultimo -= tam;
+                pdq_troca(e, base_esq + (size_t)offsets_esq[ini_esq + n_esq] * tam, ultimo);
+            }
+            primeiro = ultimo;
+        }
+        if (n_dir) {
+            while (n_dir--) {
+                pdq_troca(e, base_dir - (size_t)offsets_dir[ini_dir + n_dir] * tam, primeiro);
+                primeiro += tam;
+            }
+        }
+    }
+    
+    char* pos_pivo = primeiro - tam;
+    memcpy(inicio, pos_pivo, tam);
+    memcpy(pos_pivo, pivo, tam);
+    return pos_pivo;
+}
+
+// Particiona em [<= pivô][pivô][> pivô]. Usado quando o pivô é igual ao elemento anterior
+// ao intervalo: todos os iguais ficam à esquerda e não são mais visitados.
+static char* pdq_particao_esquerda(EstadoPdq* e, char* inicio, char* fim) {
+    int tam = e->tam;
+    char* pivo = e->pivo;
+    char* primeiro = inicio;
+    char* ultimo = fim;
+    
+    memcpy(pivo, inicio, tam);
+    
+    do { ultimo -= tam; } while (e->compara(pivo, ultimo) < 0);
+    
+    if (ultimo + tam == fim) {
+        while (primeiro < ultimo && e->compara(pivo, primeiro += tam) >= 0);
+    } else {
+        while (e->compara(pivo, primeiro += tam) >= 0);
+    }
+    
+    while (primeiro < ultimo) {
+        pdq_troca(e, primeiro, ultimo);
+        do { ultimo -= tam; } while (e->compara(pivo, ultimo) < 0);
+        do { primeiro += tam; } while (e->compara(pivo, primeiro) >= 0);
+    }
+    
+    memcpy(inicio, ultimo, tam);
+    memcpy(ultimo, pivo, tam);
+    return ultimo;
+}
+
+static void pdq_laco(EstadoPdq* e, char* inicio, char* fim, int ruins_permitidos, int mais_a_esquerda) {
+    int tam = e->tam;
+    
+    for (;;) {
+        int n = pdq_dist(e, inicio, fim);
+        
+        if (n < e->limite_insercao) {
+            pdq_insertion(e, inicio, fim, mais_a_esquerda);
+            return;
+        }
+        
+        // Pivô (mediana de 3 ou ninther) vai para *inicio
+        int meio = n / 2;
+        if (n > PDQ_LIMITE_NINTHER) {
+            pdq_ordena3(e, inicio, ELEM(inicio, meio, tam), fim - tam);
+            pdq_ordena3(e, inicio + tam, ELEM(inicio, meio - 1, tam), fim - 2 * tam);
+            pdq_ordena3(e, inicio + 2 * tam, ELEM(inicio, meio + 1, tam), fim - 3 * tam);
+            pdq_ordena3(e, ELEM(inicio, meio - 1, tam), ELEM(inicio, meio, tam), ELEM(inicio, meio + 1, tam));
+            pdq_troca(e, inicio, ELEM(inicio, meio, tam));
         } else {
-            memcpy(arr + k * tamanho_elemento, elem_dir, tamanho_elemento);
-            j++;
+            pdq_ordena3(e, ELEM(inicio, meio, tam), inicio, fim - tam);
         }
-        k++;
+        
+        // Pivô igual ao antecessor: há muitos repetidos, separa os iguais de uma vez
+        if (!mais_a_esquerda && e->compara(inicio - tam, inicio) >= 0) {
+            inicio = pdq_particao_esquerda(e, inicio, fim) + tam;
+            continue;
+        }
+        
+        int ja_particionado;
+        char* pos_pivo = (tam <= PDQ_TAM_SEM_DESVIO)
+            ? pdq_particao_sem_desvio(e, inicio, fim, &ja_particionado)
+            : pdq_particao_direita(e, inicio, fim, &ja_particionado);
+        
+        int n_esq = pdq_dist(e, inicio, pos_pivo);
+        int n_dir = pdq_dist(e, pos_pivo + tam, fim);
+        
+        if (n_esq < n / 8 || n_dir < n / 8) {
+            // Partição muito desbalanceada: após log n delas, garante O(n log n) com heapsort
+            if (--ruins_permitidos == 0) {
+                pdq_heapsort(e, inicio, fim);
+                return;
+            }
+            
+            // Embaralha alguns elementos para quebrar padrões que enganam a escolha do pivô
+            if (n_esq >= e->limite_insercao) {
+                pdq_troca(e, inicio, ELEM(inicio, n_esq / 4, tam));
+                pdq_troca(e, pos_pivo - tam, pos_pivo - (size_t)(n_esq / 4) * tam);
+                if (n_esq > PDQ_LIMITE_NINTHER) {
+                    pdq_troca(e, inicio + tam, ELEM(inicio, n_esq / 4 + 1, tam));
+                    pdq_troca(e, inicio + 2 * tam, ELEM(inicio, n_esq / 4 + 2, tam));
+                    pdq_troca(e, pos_pivo - 2 * tam, pos_pivo - (size_t)(n_esq / 4 + 1) * tam);
+                    pdq_troca(e, pos_pivo - 3 * tam, pos_pivo - (size_t)(n_esq / 4 + 2) * tam);
+                }
+            }
+            if (n_dir >= e->limite_insercao) {
+                pdq_troca(e, pos_pivo + tam, pos_pivo + (size_t)(1 + n_dir / 4) * tam);
+                pdq_troca(e, fim - tam, fim - (size_t)(n_dir / 4) * tam);
+                if (n_dir > PDQ_LIMITE_NINTHER) {
+                    pdq_troca(e, pos_pivo + 2 * tam, pos_pivo + (size_t)(2 + n_dir / 4) * tam);
+                    pdq_troca(e, pos_pivo + 3 * tam, pos_pivo + (size_t)(3 + n_dir / 4) * tam);
+                    pdq_troca(e, fim - 2 * tam, fim - (size_t)(1 + n_dir / 4) * tam);
+                    pdq_troca(e, fim - 3 * tam, fim - (size_t)(2 + n_dir / 4) * tam);
+                }
+            }
+        } else if (ja_particionado &&
+                   pdq_insertion_parcial(e, inicio, pos_pivo) &&
+                   pdq_insertion_parcial(e, pos_pivo + tam, fim)) {
+            // Entrada já (quase) ordenada: nada mais a fazer
+            return;
+        }
+        
+        // Recursão no lado esquerdo, laço no direito
+        pdq_laco(e, inicio, pos_pivo, ruins_permitidos, mais_a_esquerda);
+        inicio = pos_pivo + tam;
+        mais_a_esquerda = 0;
+    }
+}
+
+void ordena_pdqsort(void* array, int n, int tamanho_elemento, FuncaoComparacao compara) {
+    ordena_pdqsort_com_limite(array, n, tamanho_elemento, ORDENACAO_LIMITE_PDQ, compara);
+}
+
+void ordena_pdqsort_com_limite(void* array, int n, int tamanho_elemento, int limite, FuncaoComparacao compara) {
+    if (array == NULL || n <= 1 || compara == NULL) {
+        return;
+    }
+    
+    if (limite <= 0) {
+        limite = ORDENACAO_LIMITE_PDQ;
+    }
+    if (limite < PDQ_LIMITE_INSERCAO_MIN) {
+        limite = PDQ_LIMITE_INSERCAO_MIN;
     }
     
+    // Pivô e temporário de troca: na pilha para elementos pequenos
+    char temp_local[2 * TAM_TEMP_LOCAL];
+    char* temp = temp_local;
+    
+    if (tamanho_elemento > TAM_TEMP_LOCAL) {
+        temp = (char*)malloc(2 * (size_t)tamanho_elemento);
+        if (temp == NULL) {
+            printf("Erro ao alocar memória no pdqsort\n");
+            return;
+        }
+    }
+    
+    EstadoPdq e;
+    e.tam = tamanho_elemento;
+    e.compara = compara;
+    e.limite_insercao = limite;
+    e.pivo = temp;
+    e.troca = temp + tamanho_elemento;
+    
+    int ruins_permitidos = 0;
+    for (int k = n; k > 1; k >>= 1) ruins_permitidos++;
+    
+    char* inicio = (char*)array;
+    pdq_laco(&e, inicio, ELEM(inicio, n, tamanho_elemento), ruins_permitidos, 1);
+    
+    if (temp != temp_local) {
+        free(temp);
+    }
+}
 
-    while (i < n1) {
-        memcpy(arr + k * tamanho_elemento, (char*)esq + i * tamanho_elemento, tamanho_elemento);
-        i++;
-        k++;
+// Intercala origem[inicio..meio] e origem[meio+1..fim] em destino[inicio..fim] (estável).
+static void merge(const char* origem, char* destino, int inicio, int meio, int fim, int tamanho_elemento, FuncaoComparacao compara) {
+    int i = inicio, j = meio + 1, k = inicio;
+    
+    // Metades já em ordem: basta copiar
+    if (compara(ELEM(origem, meio, tamanho_elemento), ELEM(origem, meio + 1, tamanho_elemento)) <= 0) {
+        memcpy(ELEM(destino, inicio, tamanho_elemento), ELEM(origem, inicio, tamanho_elemento),
+               (size_t)(fim - inicio + 1) * tamanho_elemento);
+        return;
     }
     
-    while (j < n2) {
-        memcpy(arr + k * tamanho_elemento, (char*)dir + j * tamanho_elemento, tamanho_elemento);
-        j++;
+    while (i <= meio && j <= fim) {
+        if (compara(ELEM(origem, i, tamanho_elemento), ELEM(origem, j, tamanho_elemento)) <= 0) {
+            memcpy(ELEM(destino, k, tamanho_elemento), ELEM(origem, i, tamanho_elemento), tamanho_elemento);
+            i++;
+        } else {
+            memcpy(ELEM(destino, k, tamanho_elemento), ELEM(origem, j, tamanho_elemento), tamanho_elemento);
+            j++;
+        }
         k++;
     }
     
-    free(esq);
-    free(dir);
+    if (i <= meio) {
+        memcpy(ELEM(destino, k, tamanho_elemento), ELEM(origem, i, tamanho_elemento),
+               (size_t)(meio - i + 1) * tamanho_elemento);
+    } else if (j <= fim) {
+        memcpy(ELEM(destino, k, tamanho_elemento), ELEM(origem, j, tamanho_elemento),
+               (size_t)(fim - j + 1) * tamanho_elemento);
+    }
 }
 
 
-static void mergesort_recursivo(void* array, int inicio, int fim, int tamanho_elemento, int threshold, FuncaoComparacao compara) {
+// Ordena [inicio..fim] deixando o resultado em 'destino'.
+// 'origem' e 'destino' começam com o mesmo conteúdo nesse intervalo; a cada nível
+// os papéis se alternam (ping-pong), então nenhum merge precisa alocar ou copiar de volta.
+static void mergesort_recursivo(char* origem, char* destino, int inicio, int fim, int tamanho_elemento, int threshold, FuncaoComparacao compara, void* temp) {
     
     int tamanho = fim - inicio + 1;
     
     if (tamanho <= threshold) {
-        ordena_insertionSort(array, inicio, fim, tamanho_elemento, compara);
+        insertion_sort(destino, inicio, fim, tamanho_elemento, compara, temp);
         return;
     }
     
     if (inicio < fim) {
         int meio = inicio + (fim - inicio) / 2;
         
-
-        mergesort_recursivo(array, inicio, meio, tamanho_elemento, threshold, compara);
+        // As metades são ordenadas em 'origem' para então serem intercaladas em 'destino'
+        mergesort_recursivo(destino, origem, inicio, meio, tamanho_elemento, threshold, compara, temp);
         
-        mergesort_recursivo(array, meio + 1, fim, tamanho_elemento, threshold, compara);
+        mergesort_recursivo(destino, origem, meio + 1, fim, tamanho_elemento, threshold, compara, temp);
         
-        merge(array, inicio, meio, fim, tamanho_elemento, compara);
+        merge(origem, destino, inicio, meio, fim, tamanho_elemento, compara);
     }
 }
 
+void ordena_mergesort_com_buffer(void* array, int n, int tamanho_elemento, int threshold, FuncaoComparacao compara, void* buffer) {
+    
+    if (array == NULL || buffer == NULL || n <= 0 || compara == NULL) {
+        return;
+    }
+    
+    if (threshold <= 0) {
+        threshold = ORDENACAO_LIMITE_MERGESORT;
+    }
+    
+    // Os n primeiros elementos do buffer são a cópia de trabalho; o último é o temporário do insertion sort
+    char* aux = (char*)buffer;
+    void* temp = ELEM(aux, n, tamanho_elemento);
+    
+    memcpy(aux, array, (size_t)n * tamanho_elemento);
+    
+    mergesort_recursivo(aux, (char*)array, 0, n - 1, tamanho_elemento, threshold, compara, temp);
+}
+
 void ordena_mergesort(void* array, int n, int tamanho_elemento, int threshold, FuncaoComparacao compara) {
     
     if (array == NULL || n <= 0 || compara == NULL) {
         return;
     }
     
-    mergesort_recursivo(array, 0, n - 1, tamanho_elemento, threshold, compara);
-}
\ No newline at end of file
+    void* buffer = malloc((size_t)(n + 1) * tamanho_elemento);
+    if (buffer == NULL) {
+        printf("Erro ao alocar memória no mergesort\n");
+        return;
+    }
+    
+    ordena_mergesort_com_buffer(array, n, tamanho_elemento, threshold, compara, buffer);
+    
+    free(buffer);
+}
+
+
+/*==========================*/
+/* Ordenação Adaptativa     */
+/*==========================*/
+
+// Vitórias seguidas de uma mesma run antes de entrar no modo galope (valor inicial).
+#define MIN_GALLOP 7
+// Altura máxima da pilha de runs: os tamanhos crescem como Fibonacci, então 85 cobre qualquer int.
+#define MAX_RUNS 85
+
+typedef struct {
+    char* array;
+    int tam;
+    FuncaoComparacao compara;
+    char* temp;              // Área para a menor das duas runs de um merge (n/2 + 1 elementos)
+    char* elem;              // Temporário de um elemento
+    int min_gallop;          // Limiar adaptativo para entrar no modo galope
+    int n_runs;
+    int run_base[MAX_RUNS];
+    int run_len[MAX_RUNS];
+} EstadoAdaptativo;
+
+// Menor tamanho de run tal que n / minrun seja uma potência de 2 ou um pouco menos.
+static int calcula_minrun(int n) {
+    int r = 0;
+    while (n >= 64) {
+        r |= n & 1;
+        n >>= 1;
+    }
+    return n + r;
+}
+
+// Insertion sort binário em arr[0..n), sabendo que arr[0..inicio) já está ordenado.
+// Insere depois dos iguais, preservando a estabilidade.
+static void insertion_binario(char* arr, int n, int inicio, int tam, FuncaoComparacao compara, void* elem) {
+    for (int i = (inicio > 0) ? inicio : 1; i < n; i++) {
+        int lo = 0, hi = i;
+        void* pivo = ELEM(arr, i, tam);
+        
+        while (lo < hi) {
+            int m = lo + (hi - lo) / 2;
+            if (compara(pivo, ELEM(arr, m, tam)) < 0) {
+                hi = m;
+            } else {
+                lo = m + 1;
+            }
+        }
+        
+        if (lo < i) {
+            memcpy(elem, pivo, tam);
+            memmove(ELEM(arr, lo + 1, tam), ELEM(arr, lo, tam), (size_t)(i - lo) * tam);
+            memcpy(ELEM(arr, lo, tam), elem, tam);
+        }
+    }
+}
+
+// Tamanho da run natural que começa em arr[0]. Runs estritamente decrescentes são invertidas
+// (estritamente, para não trocar a ordem de elementos iguais).
+static int conta_run(char* arr, int n, int tam, FuncaoComparacao compara, void* elem) {
+    if (n <= 1) return n;
+    
+    int fim = 1;
+    
+    if (compara(ELEM(arr, 1, tam), ELEM(arr, 0, tam)) < 0) {
+        while (fim + 1 < n && compara(ELEM(arr, fim + 1, tam), ELEM(arr, fim, tam)) < 0) {
+            fim++;
+        }
+        
+        for (int i = 0, j = fim; i < j; i++, j--) {
+            memcpy(elem, ELEM(arr, i, tam), tam);
+            memcpy(ELEM(arr, i, tam), ELEM(arr, j, tam), tam);
+            memcpy(ELEM(arr, j, tam), elem, tam);
+        }
+    } else {
+        while (fim + 1 < n && compara(ELEM(arr, fim + 1, tam), ELEM(arr, fim, tam)) >= 0) {
+            fim++;
+        }
+    }
+    
+    return fim + 1;
+}
+
+// Posição k em a[0..n) tal que a[k-1] < chave <= a[k], buscando exponencialmente a partir de 'dica'.
+static int galope_esquerda(const void* chave, const char* a, int n, int dica, int tam, FuncaoComparacao compara) {
+    int ultimo = 0, ofs = 1;
+    
+    if (compara(ELEM(a, dica, tam), chave) < 0) {
+        int max_ofs = n - dica;
+        while (ofs < max_ofs && compara(ELEM(a, dica + ofs, tam), chave) < 0) {
+            ultimo = ofs;
+            ofs = (ofs << 1) + 1;
+            if (ofs <= 0) ofs = max_ofs;
+        }
+        if (ofs > max_ofs) ofs = max_ofs;
+        ultimo += dica;
+        ofs += dica;
+    } else {
+        int max_ofs = dica + 1;
+        while (ofs < max_ofs && compara(ELEM(a, dica - ofs, tam), chave) >= 0) {
+            ultimo = ofs;
+            ofs = (ofs << 1) + 1;
+            if (ofs <= 0) ofs = max_ofs;
+        }
+        if (ofs > max_ofs) ofs = max_ofs;
+        int k = ultimo;
+        ultimo = dica - ofs;
+        ofs = dica - k;
+    }
+    
+    // a[ultimo] < chave <= a[ofs]: busca binária no intervalo restante
+    ultimo++;
+    while (ultimo < ofs) {
+        int m = ultimo + (ofs - ultimo) / 2;
+        if (compara(ELEM(a, m, tam), chave) < 0) {
+            ultimo = m + 1;
+        } else {
+            ofs = m;
+        }
+    }
+    return ofs;
+}
+
+// Posição k em a[0..n) tal que a[k-1] <= chave < a[k], buscando exponencialmente a partir de 'dica'.
+static int galope_direita(const void* chave, const char* a, int n, int dica, int tam, FuncaoComparacao compara) {
+    int ultimo = 0, ofs = 1;
+    
+    if (compara(chave, ELEM(a, dica, tam)) < 0) {
+        int max_ofs = dica + 1;
+        while (ofs < max_ofs && compara(chave, ELEM(a, dica - ofs, tam)) < 0) {
+            ultimo = ofs;
+            ofs = (ofs << 1) + 1;
+            if (ofs <= 0) ofs = max_ofs;
+        }
+        if (ofs > max_ofs) ofs = max_ofs;
+        int k = ultimo;
+        ultimo = dica - ofs;
+        ofs = dica - k;
+    } else {
+        int max_ofs = n - dica;
+        while (ofs < max_ofs && compara(chave, ELEM(a, dica + ofs, tam)) >= 0) {
+            ultimo = ofs;
+            ofs = (ofs << 1) + 1;
+            if (ofs <= 0) ofs = max_ofs;
+        }
+        if (ofs > max_ofs) ofs = max_ofs;
+        ultimo += dica;
+        ofs += dica;
+    }
+    
+    ultimo++;
+    while (ultimo < ofs) {
+        int m = ultimo + (ofs - ultimo) / 2;
+        if (compara(chave, ELEM(a, m, tam)) < 0) {
+            ofs = m;
+        } else {
+            ultimo = m + 1;
+        }
+    }
+    return ofs;
+}
+
+// Intercala a[0..na) e b[0..nb) (b logo após a no array), com na <= nb.
+// A run 'a' vai para o temporário e o resultado é escrito da esquerda para a direita.
+static void merge_baixo(EstadoAdaptativo* e, char* a, int na, char* b, int nb) {
+    int tam = e->tam;
+    FuncaoComparacao compara = e->compara;
+    char* t = e->temp;
+    int i = 0, j = 0;
+    char* dest = a;
+    
+    memcpy(t, a, (size_t)na * tam);
+    
+    for (;;) {
+        int conta_a = 0, conta_b = 0;
+        
+        // Um elemento por vez, até uma das runs "vencer" min_gallop vezes seguidas
+        do {
+            if (compara(ELEM(b, j, tam), ELEM(t, i, tam)) < 0) {
+                memcpy(dest, ELEM(b, j, tam), tam);
+                dest += tam;
+                j++;
+                conta_b++;
+                conta_a = 0;
+                if (j == nb) goto fim;
+            } else {
+                memcpy(dest, ELEM(t, i, tam), tam);
+                dest += tam;
+                i++;
+                conta_a++;
+                conta_b = 0;
+                if (i == na) goto fim;
+            }
+        } while ((conta_a | conta_b) < e->min_gallop);
+        
+        // Modo galope: copia blocos inteiros localizados por busca exponencial
+        e->min_gallop++;
+        do {
+            if (e->min_gallop > 1) e->min_gallop--;
+            
+            conta_a = galope_direita(ELEM(b, j, tam), ELEM(t, i, tam), na - i, 0, tam, compara);
+            if (conta_a > 0) {
+                memcpy(dest, ELEM(t, i, tam), (size_t)conta_a * tam);
+                dest += (size_t)conta_a * tam;
+                i += conta_a;
+                if (i == na) goto fim;
+            }
+            memcpy(dest, ELEM(b, j, tam), tam);
+            dest += tam;
+            j++;
+            if (j == nb) goto fim;
+            
+            conta_b = galope_esquerda(ELEM(t, i, tam), ELEM(b, j, tam), nb - j, 0, tam, compara);
+            if (conta_b > 0) {
+                memmove(dest, ELEM(b, j, tam), (size_t)conta_b * tam);
+                dest += (size_t)conta_b * tam;
+                j += conta_b;
+                if (j == nb) goto fim;
+            }
+            memcpy(dest, ELEM(t, i, tam), tam);
+            dest += tam;
+            i++;
+            if (i == na) goto fim;
+        } while (conta_a >= MIN_GALLOP || conta_b >= MIN_GALLOP);
+        e->min_gallop++;
+    }
+    
+fim:
+    // O que sobrou de b já está no lugar; o que sobrou de a é copiado do temporário
+    if (i < na) {
+        memcpy(dest, ELEM(t, i, tam), (size_t)(na - i) * tam);
+    }
+}
+
+// Intercala a[0..na) e b[0..nb) (b logo após a no array), com nb < na.
+// A run 'b' vai para o temporário e o resultado é escrito da direita para a esquerda.
+static void merge_alto(EstadoAdaptativo* e, char* a, int na, char* b, int nb) {
+    int tam = e->tam;
+    FuncaoComparacao compara = e->compara;
+    char* t = e->temp;
+    int i = na - 1, j = nb - 1;
+    char* dest = ELEM(b, nb - 1, tam);
+    
+    memcpy(t, b, (size_t)nb * tam);
+    
+    for (;;) {
+        int conta_a = 0, conta_b = 0;
+        
+        do {
+            if (compara(ELEM(t, j, tam), ELEM(a, i, tam)) < 0) {
+                memcpy(dest, ELEM(a, i, tam), tam);
+                dest -= tam;
+                i--;
+                conta_a++;
+                conta_b = 0;
+                if (i < 0) goto fim;
+            } else {
+                memcpy(dest, ELEM(t, j, tam), tam);
+                dest -= tam;
+                j--;
+                conta_b++;
+                conta_a = 0;
+                if (j < 0) goto fim;
+            }
+        } while ((conta_a | conta_b) < e->min_gallop);
+        
+        e->min_gallop++;
+        do {
+            if (e->min_gallop > 1) e->min_gallop--;
+            
+            // Elementos de a maiores que t[j] vão todos depois dele
+            conta_a = (i + 1) - galope_direita(ELEM(t, j, tam), a, i + 1, i, tam, compara);
+            if (conta_a > 0) {
+                dest -= (size_t)(conta_a - 1) * tam;
+                memmove(dest, ELEM(a, i - conta_a + 1, tam), (size_t)conta_a * tam);
+                dest -= tam;
+                i -= conta_a;
+                if (i < 0) goto fim;
+            }
+            memcpy(dest, ELEM(t, j, tam), tam);
+            dest -= tam;
+            j--;
+            if (j < 0) goto fim;
+            
+            // Elementos de b maiores ou iguais a a[i] vão todos depois dele
+            conta_b = (j + 1) - galope_esquerda(ELEM(a, i, tam), t, j + 1, j, tam, compara);
+            if (conta_b > 0) {
+                dest -= (size_t)(conta_b - 1) * tam;
+                memcpy(dest, ELEM(t, j - conta_b + 1, tam), (size_t)conta_b * tam);
+                dest -= tam;
+                j -= conta_b;
+                if (j < 0) goto fim;
+            }
+            memcpy(dest, ELEM(a, i, tam), tam);
+            dest -= tam;
+            i--;
+            if (i < 0) goto fim;
+        } while (conta_a >= MIN_GALLOP || conta_b >= MIN_GALLOP);
+        e->min_gallop++;
+    }
+    
+fim:
+    // O que sobrou de a já está no lugar; o que sobrou de b vai para o início
+    if (j >= 0) {
+        memcpy(a, t, (size_t)(j + 1) * tam);
+    }
+}
+
+// Intercala as runs k e k + 1 da pilha.
+static void merge_runs(EstadoAdaptativo* e, int k) {
+    int tam = e->tam;
+    char* a = ELEM(e->array, e->run_base[k], tam);
+    int na = e->run_len[k];
+    char* b = ELEM(e->array, e->run_base[k + 1], tam);
+    int nb = e->run_len[k + 1];
+    
+    e->run_len[k] = na + nb;
+    if (k == e->n_runs - 3) {
+        e->run_base[k + 1] = e->run_base[k + 2];
+        e->run_len[k + 1] = e->run_len[k + 2];
+    }
+    e->n_runs--;
+    
+    // Elementos de a que já são <= b[0] e de b que já são >= a[na-1] não se movem
+    int pula = galope_direita(b, a, na, 0, tam, e->compara);
+    a += (size_t)pula * tam;
+    na -= pula;
+    if (na == 0) return;
+    
+    nb = galope_esquerda(ELEM(a, na - 1, tam), b, nb, nb - 1, tam, e->compara);
+    if (nb == 0) return;
+    
+    if (na <= nb) {
+        merge_baixo(e, a, na, b, nb);
+    } else {
+        merge_alto(e, a, na, b, nb);
+    }
+}
+
+// Mantém os tamanhos das runs na pilha decrescendo mais rápido que Fibonacci.
+static void colapsa_runs(EstadoAdaptativo* e) {
+    while (e->n_runs > 1) {
+        int k = e->n_runs - 2;
+        int* len = e->run_len;
+        
+        if ((k > 0 && len[k - 1] <= len[k] + len[k + 1]) ||
+            (k > 1 && len[k - 2] <= len[k - 1] + len[k])) {
+            if (len[k - 1] < len[k + 1]) k--;
+        } else if (len[k] > len[k + 1]) {
+            break;
+        }
+        merge_runs(e, k);
+    }
+}
+
+void ordena_adaptativo(void* array, int n, int tamanho_elemento, FuncaoComparacao compara) {
+    
+    if (array == NULL || n <= 1 || compara == NULL) {
+        return;
+    }
+    
+    EstadoAdaptativo e;
+    e.array = (char*)array;
+    e.tam = tamanho_elemento;
+    e.compara = compara;
+    e.min_gallop = MIN_GALLOP;
+    e.n_runs = 0;
+    e.temp = (char*)malloc((size_t)(n / 2 + 2) * tamanho_elemento);
+    if (e.temp == NULL) {
+        printf("Erro ao alocar memória na ordenacao adaptativa\n");
+        return;
+    }
+    e.elem = ELEM(e.temp, n / 2 + 1, tamanho_elemento);
+    
+    int minrun = calcula_minrun(n);
+    int inicio = 0;
+    
+    while (inicio < n) {
+        char* base = ELEM(e.array, inicio, tamanho_elemento);
+        int restante = n - inicio;
+        int len = conta_run(base, restante, tamanho_elemento, compara, e.elem);
+        
+        if (len < minrun) {
+            int forcado = (restante < minrun) ? restante : minrun;
+            insertion_binario(base, forcado, len, tamanho_elemento, compara, e.elem);
+            len = forcado;
+        }
+        
+        e.run_base[e.n_runs] = inicio;
+        e.run_len[e.n_runs] = len;
+        e.n_runs++;
+        colapsa_runs(&e);
+        
+        inicio += len;
+    }
+    
+    while (e.n_runs > 1) {
+        int k = e.n_runs - 2;
+        if (k > 0 && e.run_len[k - 1] < e.run_len[k + 1]) k--;
+        merge_runs(&e, k);
+    }
+    
+    free(e.temp);
+}
+
+/*==========================*/
+/* MergeSort Paralelo       */
+/*==========================*/
+
+typedef struct {
+    char* origem;
+    char* destino;
+    int inicio, fim;          // Intervalo [inicio..fim] ordenado por esta tarefa
+    int tamanho_elemento;
+    int threshold;
+    FuncaoComparacao compara;
+    void* temp;               // Temporário próprio da thread para o insertion sort
+} TarefaOrdena;
+
+typedef struct {
+    const char* a;            // Trecho da sequência da esquerda
+    int na;
+    const char* b;            // Trecho da sequência da direita
+    int nb;
+    char* destino;
+    int tamanho_elemento;
+    FuncaoComparacao compara;
+} TarefaIntercala;
+
+static void* executa_ordena(void* arg) {
+    TarefaOrdena* t = (TarefaOrdena*)arg;
+    
+    mergesort_recursivo(t->origem, t->destino, t->inicio, t->fim, t->tamanho_elemento, t->threshold, t->compara, t->temp);
+    
+    return NULL;
+}
+
+// Intercala a[0..na) e b[0..nb) em destino, preferindo 'a' nos empates (estável).
+static void* executa_intercala(void* arg) {
+    TarefaIntercala* t = (TarefaIntercala*)arg;
+    int tam = t->tamanho_elemento;
+    int i = 0, j = 0, k = 0;
+    
+    while (i < t->na && j < t->nb) {
+        if (t->compara(ELEM(t->a, i, tam), ELEM(t->b, j, tam)) <= 0) {
+            memcpy(ELEM(t->destino, k++, tam), ELEM(t->a, i++, tam), tam);
+        } else {
+            memcpy(ELEM(t->destino, k++, tam), ELEM(t->b, j++, tam), tam);
+        }
+    }
+    
+    if (i < t->na) {
+        memcpy(ELEM(t->destino, k, tam), ELEM(t->a, i, tam), (size_t)(t->na - i) * tam);
+    } else if (j < t->nb) {
+        memcpy(ELEM(t->destino, k, tam), ELEM(t->b, j, tam), (size_t)(t->nb - j) * tam);
+    }
+    
+    return NULL;
+}
+
+// Quantos elementos de 'a' estão entre os k primeiros da intercalação estável de a e b.
+// Busca binária pela divisão (i, k - i) em que a[i-1] <= b[j] e b[j-1] < a[i].
+static int divide_intercalacao(const char* a, int na, const char* b, int nb, int k, int tam, FuncaoComparacao compara) {
+    int lo = (k > nb) ? k - nb : 0;
+    int hi = (k < na) ? k : na;
+    
+    while (lo < hi) {
+        int i = lo + (hi - lo) / 2;
+        int j = k - i;
+        
+        if (j > 0 && compara(ELEM(b, j - 1, tam), ELEM(a, i, tam)) >= 0) {
+            lo = i + 1;
+        } else {
+            hi = i;
+        }
+    }
+    
+    return lo;
+}
+
+// Executa as tarefas em threads; se uma thread não puder ser criada, a tarefa roda na thread atual.
+static void executa_em_threads(void* (*funcao)(void*), void* tarefas, size_t tamanho_tarefa, int n_tarefas) {
+    pthread_t* threads = (pthread_t*)malloc(n_tarefas * sizeof(pthread_t));
+    char* criada = (char*)calloc(n_tarefas, 1);
+    
+    for (int i = 0; i < n_tarefas; i++) {
+        void* tarefa = (char*)tarefas + i * tamanho_tarefa;
+        
+        if (threads != NULL && criada != NULL && i > 0 && pthread_create(&threads[i], NULL, funcao, tarefa) == 0) {
+            criada[i] = 1;
+        } else if (i > 0) {
+            funcao(tarefa);
+        }
+    }
+    
+    // A primeira tarefa fica com a thread chamadora
+    if (n_tarefas > 0) {
+        funcao(tarefas);
+    }
+    
+    for (int i = 1; i < n_tarefas; i++) {
+        if (criada != NULL && criada[i]) {
+            pthread_join(threads[i], NULL);
+        }
+    }
+    
+    free(threads);
+    free(criada);
+}
+
+void ordena_mergesort_paralelo(void* array, int n, int tamanho_elemento, int threshold, FuncaoComparacao compara, int n_threads) {
+    
+    if (array == NULL || n <= 0 || compara == NULL) {
+        return;
+    }
+    
+    if (n_threads > n / MIN_ELEMENTOS_POR_THREAD) {
+        n_threads = n / MIN_ELEMENTOS_POR_THREAD;
+    }
+    
+    if (n_threads <= 1) {
+        ordena_mergesort(array, n, tamanho_elemento, threshold, compara);
+        return;
+    }
+    
+    if (threshold <= 0) {
+        threshold = ORDENACAO_LIMITE_MERGESORT;
+    }
+    
+    // n elementos de trabalho + um temporário por thread
+    char* aux = (char*)malloc((size_t)(n + n_threads) * tamanho_elemento);
+    int* limites = (int*)malloc((n_threads + 1) * sizeof(int));
+    TarefaOrdena* ordena = (TarefaOrdena*)malloc(n_threads * sizeof(TarefaOrdena));
+    TarefaIntercala* intercala = (TarefaIntercala*)malloc(n_threads * sizeof(TarefaIntercala));
+    
+    if (aux == NULL || limites == NULL || ordena == NULL || intercala == NULL) {
+        printf("Erro ao alocar memória no mergesort paralelo\n");
+        free(aux);
+        free(limites);
+        free(ordena);
+        free(intercala);
+        return;
+    }
+    
+    char* arr = (char*)array;
+    int n_trechos = n_threads;
+    
+    for (int t = 0; t <= n_trechos; t++) {
+        limites[t] = (int)((long long)n * t / n_trechos);
+    }
+    
+    // Conta as rodadas de intercalação para que o resultado final caia em 'array'
+    int rodadas = 0;
+    for (int r = n_trechos; r > 1; r = (r + 1) / 2) {
+        rodadas++;
+    }
+    
+    char* atual = (rodadas % 2 == 0) ? arr : aux;
+    char* outro = (atual == arr) ? aux : arr;
+    
+    // Fase 1: cada thread ordena o seu trecho, deixando o resultado em 'atual'
+    memcpy(aux, arr, (size_t)n * tamanho_elemento);
+    
+    for (int t = 0; t < n_trechos; t++) {
+        ordena[t].origem = outro;
+        ordena[t].destino = atual;
+        ordena[t].inicio = limites[t];
+        ordena[t].fim = limites[t + 1] - 1;
+        ordena[t].tamanho_elemento = tamanho_elemento;
+        ordena[t].threshold = threshold;
+        ordena[t].compara = compara;
+        ordena[t].temp = ELEM(aux, n + t, tamanho_elemento);
+    }
+    executa_em_threads(executa_ordena, ordena, sizeof(TarefaOrdena), n_trechos);
+    
+    // Fase 2: intercala os trechos aos pares. Cada intercalação é dividida por busca binária
+    // em partes de saída de tamanho parecido, para que todas as threads trabalhem em toda rodada.
+    while (n_trechos > 1) {
+        int pares = (n_trechos + 1) / 2;
+        int partes_por_par = n_threads / pares;
+        if (partes_por_par < 1) partes_por_par = 1;
+        
+        int n_tarefas = 0;
+        
+        for (int p = 0; p < pares; p++) {
+            int ini_a = limites[2 * p];
+            int ini_b = limites[(2 * p + 1 < n_trechos) ? 2 * p + 1 : n_trechos];
+            int fim_b = limites[(2 * p + 2 < n_trechos) ? 2 * p + 2 : n_trechos];
+            
+            const char* a = ELEM(atual, ini_a, tamanho_elemento);
+            const char* b = ELEM(atual, ini_b, tamanho_elemento);
+            int na = ini_b - ini_a;
+            int nb = fim_b - ini_b;
+            int total = na + nb;
+            
+            int i_ant = 0, k_ant = 0;
+            for (int q = 1; q <= partes_por_par; q++) {
+                int k = (int)((long long)total * q / partes_por_par);
+                int i = (k == total) ? na : divide_intercalacao(a, na, b, nb, k, tamanho_elemento, compara);
+                
+                TarefaIntercala* t = &intercala[n_tarefas++];
+                t->a = ELEM(a, i_ant, tamanho_elemento);
+                t->na = i - i_ant;
+                t->b = ELEM(b, k_ant - i_ant, tamanho_elemento);
+                t->nb = (k - i) - (k_ant - i_ant);
+                t->destino = ELEM(outro, ini_a + k_ant, tamanho_elemento);
+                t->tamanho_elemento = tamanho_elemento;
+                t->compara = compara;
+                
+                i_ant = i;
+                k_ant = k;
+            }
+        }
+        
+        executa_em_threads(executa_intercala, intercala, sizeof(TarefaIntercala), n_tarefas);
+        
+        for (int p = 0; p < pares; p++) {
+            limites[p] = limites[2 * p];
+        }
+        limites[pares] = n;
+        n_trechos = pares;
+        
+        char* troca = atual;
+        atual = outro;
+        outro = troca;
+    }
+    
+    free(aux);
+    free(limites);
+    free(ordena);
+    free(intercala);
+}
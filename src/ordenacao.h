@@ -18,12 +18,29 @@
 */
 typedef int (*FuncaoComparacao)(const void* a, const void* b);
 
+/*
+* Limites para trocar para o Insertion Sort em subarrays pequenos.
+* Os valores padrão podem ser substituídos pelos medidos em 'make bench-sort', que gera
+* ordenacao_tuned.h; o Makefile define ORDENACAO_TUNADO quando esse arquivo existe.
+*/
+#ifdef ORDENACAO_TUNADO
+#include "ordenacao_tuned.h"
+#endif
+
+#ifndef ORDENACAO_LIMITE_MERGESORT
+#define ORDENACAO_LIMITE_MERGESORT 16
+#endif
+
+#ifndef ORDENACAO_LIMITE_PDQ
+#define ORDENACAO_LIMITE_PDQ 24
+#endif
+
 /*==========================*/
 /* Algoritmos de Ordenação  */
 /*==========================*/
 
 /**
- * @brief Ordena um array usando o QuickSort (wrapper para qsort da stdlib).
+ * @brief Ordena um array usando o QuickSort (ordenação não estável padrão, via ordena_pdqsort).
  * @param array O array a ser ordenado.
  * @param n Número de elementos no array.
  * @param tamanho_elemento Tamanho em bytes de cada elemento (sizeof).
@@ -31,17 +48,73 @@ typedef int (*FuncaoComparacao)(const void* a, const void* b);
  */
 void ordena_qsort(void* array, int n, int tamanho_elemento, FuncaoComparacao compara);
 
+/**
+ * @brief Ordena um array usando o Pattern-Defeating QuickSort (pdqsort). Não estável.
+ * Pivô por mediana de 3 (ou ninther em subarrays grandes), insertion sort parcial para
+ * entradas quase ordenadas, separação rápida de repetidos e heapsort como garantia de
+ * O(n log n). Elementos pequenos usam partição sem desvios (BlockQuicksort).
+ * @param array O array a ser ordenado.
+ * @param n Número de elementos no array.
+ * @param tamanho_elemento Tamanho em bytes de cada elemento (sizeof).
+ * @param compara Função de comparação entre dois elementos.
+ */
+void ordena_pdqsort(void* array, int n, int tamanho_elemento, FuncaoComparacao compara);
+
+/**
+ * @brief pdqsort com limite do Insertion Sort escolhido pelo chamador (usado na calibração).
+ * @param limite Subarrays menores que isso vão para o Insertion Sort (<= 0 usa ORDENACAO_LIMITE_PDQ).
+ */
+void ordena_pdqsort_com_limite(void* array, int n, int tamanho_elemento, int limite, FuncaoComparacao compara);
+
 /**
  * @brief Ordena um array usando o MergeSort (implementação robusta).
  * Algoritmo estável, ideal para listas encadeadas ou quando a estabilidade é necessária.
+ * Faz uma única alocação de n + 1 elementos e alterna origem/destino entre os níveis.
  * @param array O array a ser ordenado.
  * @param n Número de elementos.
  * @param tamanho_elemento Tamanho em bytes de cada elemento.
- * @param threshold Limite para trocar para Insertion Sort em subarrays pequenos (otimização).
+ * @param threshold Limite para trocar para Insertion Sort em subarrays pequenos (<= 0 usa ORDENACAO_LIMITE_MERGESORT).
  * @param compara Função de comparação.
  */
 void ordena_mergesort(void* array, int n, int tamanho_elemento, int threshold, FuncaoComparacao compara);
 
+/**
+ * @brief MergeSort usando um buffer auxiliar fornecido pelo chamador.
+ * Permite reaproveitar a mesma memória entre ordenações repetidas; não faz nenhuma alocação.
+ * @param array O array a ser ordenado.
+ * @param n Número de elementos.
+ * @param tamanho_elemento Tamanho em bytes de cada elemento.
+ * @param threshold Limite para trocar para Insertion Sort em subarrays pequenos (<= 0 usa ORDENACAO_LIMITE_MERGESORT).
+ * @param compara Função de comparação.
+ * @param buffer Área com espaço para pelo menos (n + 1) elementos.
+ */
+void ordena_mergesort_com_buffer(void* array, int n, int tamanho_elemento, int threshold, FuncaoComparacao compara, void* buffer);
+
+/**
+ * @brief Ordenação adaptativa estável (estilo Timsort), indicada para dados quase ordenados.
+ * Detecta runs naturais (invertendo as estritamente decrescentes), estende runs curtas com
+ * insertion sort binário e as intercala com galope. Em entradas já ordenadas custa O(n).
+ * @param array O array a ser ordenado.
+ * @param n Número de elementos.
+ * @param tamanho_elemento Tamanho em bytes de cada elemento.
+ * @param compara Função de comparação.
+ */
+void ordena_adaptativo(void* array, int n, int tamanho_elemento, FuncaoComparacao compara);
+
+/**
+ * @brief MergeSort paralelo (pthreads), estável e com o mesmo resultado de ordena_mergesort.
+ * Cada thread ordena um trecho do array; os trechos são então intercalados aos pares,
+ * e cada intercalação é dividida entre as threads por busca binária, de modo que
+ * nem a última rodada fica serial. Arrays pequenos são ordenados de forma serial.
+ * @param array O array a ser ordenado.
+ * @param n Número de elementos.
+ * @param tamanho_elemento Tamanho em bytes de cada elemento.
+ * @param threshold Limite para trocar para Insertion Sort em subarrays pequenos (<= 0 usa ORDENACAO_LIMITE_MERGESORT).
+ * @param compara Função de comparação (deve poder ser chamada de várias threads).
+ * @param n_threads Número máximo de threads a usar.
+ */
+void ordena_mergesort_paralelo(void* array, int n, int tamanho_elemento, int threshold, FuncaoComparacao compara, int n_threads);
+
 /*==========================*/
 /* Algoritmos Auxiliares    */
 /*==========================*/
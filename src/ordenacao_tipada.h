@@ -0,0 +1,340 @@
+#ifndef ORDENACAO_TIPADA_H
+#define ORDENACAO_TIPADA_H
+
+/*
+* Ordenações especializadas por tipo, geradas em tempo de compilação.
+* As funções de ordenacao.h são genéricas: cada comparação passa por um ponteiro
+* de função e cada movimento é um memcpy de tamanho variável. Aqui o macro
+* ORDENACAO_DEFINE instancia versões para um tipo concreto, em que a comparação
+* é uma expressão (inlinável) e os movimentos são atribuições.
+*
+* Uso:
+*     #define MENOR_DOUBLE(a, b) ((a) < (b))
+*     ORDENACAO_DEFINE(doubles, double, MENOR_DOUBLE)
+*
+* Gera (todas static inline, com 'v' um array de 'tipo' e 'n' o número de elementos):
+*     void nome_insertion(tipo* v, int n);                       // estável
+*     void nome_mergesort_com_buffer(tipo* v, int n, tipo* aux); // estável, aux com n elementos
+*     void nome_mergesort(tipo* v, int n);                       // estável, aloca o auxiliar
+*     void nome_introsort(tipo* v, int n);                       // não estável, O(n log n) garantido
+*     void nome_pdqsort(tipo* v, int n);                         // não estável, pattern-defeating
+*
+* 'menor(a, b)' recebe dois valores do tipo e deve ser verdadeiro se a < b.
+*/
+
+#include "ordenacao.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Subarrays até esse tamanho são finalizados com insertion sort.
+#ifndef ORDENACAO_LIMITE_INSERCAO
+#define ORDENACAO_LIMITE_INSERCAO 16
+#endif
+
+// Limite do insertion sort no pdqsort: o mesmo de ordenacao.c (ORDENACAO_LIMITE_PDQ,
+// calibrado por 'make bench-sort'), com o mesmo mínimo de 8 para a quebra de padrões.
+#define ORDENACAO_TIPADA_LIMITE_PDQ (ORDENACAO_LIMITE_PDQ < 8 ? 8 : ORDENACAO_LIMITE_PDQ)
+// Acima disso o pivô do pdqsort é a pseudomediana de 9 (ninther) em vez da mediana de 3.
+#define ORDENACAO_TIPADA_LIMITE_NINTHER 128
+
+#define ORDENACAO_DEFINE(nome, tipo, menor)                                             \
+                                                                                        \
+static inline void nome##_insertion(tipo* v, int n) {                                   \
+    for (int i = 1; i < n; i++) {                                                       \
+        tipo x = v[i];                                                                  \
+        int j = i - 1;                                                                  \
+        while (j >= 0 && menor(x, v[j])) {                                              \
+            v[j + 1] = v[j];                                                            \
+            j--;                                                                        \
+        }                                                                               \
+        v[j + 1] = x;                                                                   \
+    }                                                                                   \
+}                                                                                       \
+                                                                                        \
+/* Ordena [ini, fim) deixando o resultado em 'dst'; 'src' e 'dst' começam iguais. */    \
+static inline void nome##_mergesort_rec(tipo* src, tipo* dst, int ini, int fim) {       \
+    if (fim - ini <= ORDENACAO_LIMITE_INSERCAO) {                                       \
+        nome##_insertion(dst + ini, fim - ini);                                         \
+        return;                                                                         \
+    }                                                                                   \
+    int meio = ini + (fim - ini) / 2;                                                   \
+    nome##_mergesort_rec(dst, src, ini, meio);                                          \
+    nome##_mergesort_rec(dst, src, meio, fim);                                          \
+    if (!menor(src[meio], src[meio - 1])) {                                             \
+        memcpy(dst + ini, src + ini, (size_t)(fim - ini) * sizeof(tipo));               \
+        return;                                                                         \
+    }                                                                                   \
+    int i = ini, j = meio, k = ini;                                                     \
+    while (i < meio && j < fim) {                                                       \
+        dst[k++] = menor(src[j], src[i]) ? src[j++] : src[i++];                         \
+    }                                                                                   \
+    while (i < meio) dst[k++] = src[i++];                                               \
+    while (j < fim) dst[k++] = src[j++];                                                \
+}                                                                                       \
+                                                                                        \
+static inline void nome##_mergesort_com_buffer(tipo* v, int n, tipo* aux) {             \
+    if (v == NULL || aux == NULL || n <= 1) return;                                     \
+    memcpy(aux, v, (size_t)n * sizeof(tipo));                                           \
+    nome##_mergesort_rec(aux, v, 0, n);                                                 \
+}                                                                                       \
+                                                                                        \
+static inline void nome##_mergesort(tipo* v, int n) {                                   \
+    if (v == NULL || n <= 1) return;                                                    \
+    tipo* aux = (tipo*)malloc((size_t)n * sizeof(tipo));                                \
+    if (aux == NULL) {                                                                  \
+        nome##_insertion(v, n);                                                         \
+        return;                                                                         \
+    }                                                                                   \
+    nome##_mergesort_com_buffer(v, n, aux);                                             \
+    free(aux);                                                                          \
+}                                                                                       \
+                                                                                        \
+static inline void nome##_peneira(tipo* v, int raiz, int n) {                           \
+    tipo x = v[raiz];                                                                   \
+    int filho;                                                                          \
+    while ((filho = 2 * raiz + 1) < n) {                                                \
+        if (filho + 1 < n && menor(v[filho], v[filho + 1])) filho++;                    \
+        if (!menor(x, v[filho])) break;                                                 \
+        v[raiz] = v[filho];                                                             \
+        raiz = filho;                                                                   \
+    }                                                                                   \
+    v[raiz] = x;                                                                        \
+}                                                                                       \
+                                                                                        \
+static inline void nome##_heapsort(tipo* v, int n) {                                    \
+    for (int i = n / 2 - 1; i >= 0; i--) nome##_peneira(v, i, n);                       \
+    for (int i = n - 1; i > 0; i--) {                                                   \
+        tipo t = v[0]; v[0] = v[i]; v[i] = t;                                           \
+        nome##_peneira(v, 0, i);                                                        \
+    }                                                                                   \
+}                                                                                       \
+                                                                                        \
+static inline void nome##_introsort_rec(tipo* v, int n, int profundidade) {             \
+    while (n > ORDENACAO_LIMITE_INSERCAO) {                                             \
+        if (profundidade-- == 0) {                                                      \
+            nome##_heapsort(v, n);                                                      \
+            return;                                                                     \
+        }                                                                               \
+        /* Mediana de três entre início, meio e fim vira o pivô em v[0] */              \
+        int m = n / 2;                                                                  \
+        tipo t;                                                                         \
+        if (menor(v[m], v[0])) { t = v[m]; v[m] = v[0]; v[0] = t; }                     \
+        if (menor(v[n - 1], v[m])) {                                                    \
+            t = v[n - 1]; v[n - 1] = v[m]; v[m] = t;                                    \
+            if (menor(v[m], v[0])) { t = v[m]; v[m] = v[0]; v[0] = t; }                 \
+        }                                                                               \
+        t = v[0]; v[0] = v[m]; v[m] = t;                                                \
+        tipo pivo = v[0];                                                               \
+        /* Partição de Hoare com o pivô em v[0]; j para no pivô no pior caso */         \
+        int i = 0, j = n;                                                               \
+        for (;;) {                                                                      \
+            do { i++; } while (i < n && menor(v[i], pivo));                             \
+            do { j--; } while (menor(pivo, v[j]));                                      \
+            if (i >= j) break;                                                          \
+            t = v[i]; v[i] = v[j]; v[j] = t;                                            \
+        }                                                                               \
+        v[0] = v[j]; v[j] = pivo;                                                       \
+        /* Recursão no lado menor, laço no maior: pilha O(log n) */                     \
+        if (j < n - j - 1) {                                                            \
+            nome##_introsort_rec(v, j, profundidade);                                   \
+            v += j + 1;                                                                 \
+            n -= j + 1;                                                                 \
+        } else {                                                                        \
+            nome##_introsort_rec(v + j + 1, n - j - 1, profundidade);                   \
+            n = j;                                                                      \
+        }                                                                               \
+    }                                                                                   \
+    nome##_insertion(v, n);                                                             \
+}                                                                                       \
+                                                                                        \
+static inline void nome##_introsort(tipo* v, int n) {                                   \
+    if (v == NULL || n <= 1) return;                                                    \
+    int profundidade = 0;                                                               \
+    for (int k = n; k > 1; k >>= 1) profundidade += 2;                                  \
+    nome##_introsort_rec(v, n, profundidade);                                           \
+}                                                                                       \
+                                                                                        \
+/* pdqsort: mesmo algoritmo de ordena_pdqsort (ordenacao.c), sobre índices de 'v' */    \
+static inline void nome##_pdq_ordena3(tipo* v, int a, int b, int c) {                   \
+    tipo t;                                                                             \
+    if (menor(v[b], v[a])) { t = v[a]; v[a] = v[b]; v[b] = t; }                         \
+    if (menor(v[c], v[b])) { t = v[b]; v[b] = v[c]; v[c] = t; }                         \
+    if (menor(v[b], v[a])) { t = v[a]; v[a] = v[b]; v[b] = t; }                         \
+}                                                                                       \
+                                                                                        \
+/* Insertion sort sem teste de limite: v[-1] é <= a todos os elementos */               \
+static inline void nome##_pdq_insertion_sem_guarda(tipo* v, int n) {                    \
+    for (int i = 1; i < n; i++) {                                                       \
+        tipo x = v[i];                                                                  \
+        int j = i - 1;                                                                  \
+        while (menor(x, v[j])) {                                                        \
+            v[j + 1] = v[j];                                                            \
+            j--;                                                                        \
+        }                                                                               \
+        v[j + 1] = x;                                                                   \
+    }                                                                                   \
+}                                                                                       \
+                                                                                        \
+static inline int nome##_pdq_insertion_parcial(tipo* v, int n) {                        \
+    int movimentos = 0;                                                                 \
+    for (int i = 1; i < n; i++) {                                                       \
+        tipo x = v[i];                                                                  \
+        int j = i - 1;                                                                  \
+        while (j >= 0 && menor(x, v[j])) {                                              \
+            v[j + 1] = v[j];                                                            \
+            j--;                                                                        \
+        }                                                                               \
+        v[j + 1] = x;                                                                   \
+        movimentos += i - (j + 1);                                                      \
+        if (movimentos > 8) return 0;                                                   \
+    }                                                                                   \
+    return 1;                                                                           \
+}                                                                                       \
+                                                                                        \
+/* Partição [< pivô][pivô][>= pivô] com blocos de offsets; pivô em v[0] */              \
+static inline int nome##_pdq_particao(tipo* v, int n, int* ja_particionado) {           \
+    tipo pivo = v[0];                                                                   \
+    tipo t;                                                                             \
+    int primeiro = 0, ultimo = n;                                                       \
+    while (menor(v[++primeiro], pivo));                                                 \
+    if (primeiro == 1) {                                                                \
+        while (primeiro < ultimo && !menor(v[--ultimo], pivo));                         \
+    } else {                                                                            \
+        while (!menor(v[--ultimo], pivo));                                              \
+    }                                                                                   \
+    *ja_particionado = primeiro >= ultimo;                                              \
+    if (!*ja_particionado) {                                                            \
+        t = v[primeiro]; v[primeiro] = v[ultimo]; v[ultimo] = t;                        \
+        primeiro++;                                                                     \
+        unsigned char off_esq[64], off_dir[64];                                         \
+        int base_esq = primeiro, base_dir = ultimo;                                     \
+        int n_esq = 0, n_dir = 0, ini_esq = 0, ini_dir = 0;                             \
+        while (primeiro < ultimo) {                                                     \
+            int desconhecidos = ultimo - primeiro;                                      \
+            int parte_esq = n_esq == 0 ? (n_dir == 0 ? desconhecidos / 2 : desconhecidos) : 0;\
+            int parte_dir = n_dir == 0 ? desconhecidos - parte_esq : 0;                 \
+            if (parte_esq > 64) parte_esq = 64;                                         \
+            if (parte_dir > 64) parte_dir = 64;                                         \
+            for (int i = 0; i < parte_esq; i++) {                                       \
+                off_esq[n_esq] = (unsigned char)i;                                      \
+                n_esq += !menor(v[primeiro], pivo);                                     \
+                primeiro++;                                                             \
+            }                                                                           \
+            for (int i = 0; i < parte_dir; i++) {                                       \
+                off_dir[n_dir] = (unsigned char)(i + 1);                                \
+                n_dir += menor(v[--ultimo], pivo);                                      \
+            }                                                                           \
+            int num = n_esq < n_dir ? n_esq : n_dir;                                    \
+            for (int i = 0; i < num; i++) {                                             \
+                int a = base_esq + off_esq[ini_esq + i];                                \
+                int b = base_dir - off_dir[ini_dir + i];                                \
+                t = v[a]; v[a] = v[b]; v[b] = t;                                        \
+            }                                                                           \
+            n_esq -= num; n_dir -= num;                                                 \
+            ini_esq += num; ini_dir += num;                                             \
+            if (n_esq == 0) { ini_esq = 0; base_esq = primeiro; }                       \
+            if (n_dir == 0) { ini_dir = 0; base_dir = ultimo; }                         \
+        }                                                                               \
+        if (n_esq) {                                                                    \
+            while (n_esq--) {                                                           \
+                int a = base_esq + off_esq[ini_esq + n_esq];                            \
+                ultimo--;                                                               \
+                t = v[a]; v[a] = v[ultimo]; v[ultimo] = t;                              \
+            }                                                                           \
+            primeiro = ultimo;                                                          \
+        }                                                                               \
+        if (n_dir) {                                                                    \
+            while (n_dir--) {                                                           \
+                int b = base_dir - off_dir[ini_dir + n_dir];                            \
+                t = v[b]; v[b] = v[primeiro]; v[primeiro] = t;                          \
+                primeiro++;                                                             \
+            }                                                                           \
+        }                                                                               \
+    }                                                                                   \
+    v[0] = v[primeiro - 1];                                                             \
+    v[primeiro - 1] = pivo;                                                             \
+    return primeiro - 1;                                                                \
+}                                                                                       \
+                                                                                        \
+/* Partição [<= pivô][pivô][> pivô], para quando o pivô repete o antecessor */          \
+static inline int nome##_pdq_particao_esquerda(tipo* v, int n) {                        \
+    tipo pivo = v[0];                                                                   \
+    tipo t;                                                                             \
+    int primeiro = 0, ultimo = n;                                                       \
+    while (menor(pivo, v[--ultimo]));                                                   \
+    if (ultimo + 1 == n) {                                                              \
+        while (primeiro < ultimo && !menor(pivo, v[++primeiro]));                       \
+    } else {                                                                            \
+        while (!menor(pivo, v[++primeiro]));                                            \
+    }                                                                                   \
+    while (primeiro < ultimo) {                                                         \
+        t = v[primeiro]; v[primeiro] = v[ultimo]; v[ultimo] = t;                        \
+        while (menor(pivo, v[--ultimo]));                                               \
+        while (!menor(pivo, v[++primeiro]));                                            \
+    }                                                                                   \
+    v[0] = v[ultimo];                                                                   \
+    v[ultimo] = pivo;                                                                   \
+    return ultimo;                                                                      \
+}                                                                                       \
+                                                                                        \
+static inline void nome##_pdq_laco(tipo* v, int n, int ruins, int mais_a_esquerda) {    \
+    tipo t;                                                                             \
+    for (;;) {                                                                          \
+        if (n < ORDENACAO_TIPADA_LIMITE_PDQ) {                                          \
+            if (mais_a_esquerda) nome##_insertion(v, n);                                \
+            else nome##_pdq_insertion_sem_guarda(v, n);                                 \
+            return;                                                                     \
+        }                                                                               \
+        int m = n / 2;                                                                  \
+        if (n > ORDENACAO_TIPADA_LIMITE_NINTHER) {                                      \
+            nome##_pdq_ordena3(v, 0, m, n - 1);                                         \
+            nome##_pdq_ordena3(v, 1, m - 1, n - 2);                                     \
+            nome##_pdq_ordena3(v, 2, m + 1, n - 3);                                     \
+            nome##_pdq_ordena3(v, m - 1, m, m + 1);                                     \
+            t = v[0]; v[0] = v[m]; v[m] = t;                                            \
+        } else {                                                                        \
+            nome##_pdq_ordena3(v, m, 0, n - 1);                                         \
+        }                                                                               \
+        if (!mais_a_esquerda && !menor(v[-1], v[0])) {                                  \
+            int p = nome##_pdq_particao_esquerda(v, n) + 1;                             \
+            v += p;                                                                     \
+            n -= p;                                                                     \
+            continue;                                                                   \
+        }                                                                               \
+        int ja_particionado;                                                            \
+        int p = nome##_pdq_particao(v, n, &ja_particionado);                            \
+        int n_esq = p, n_dir = n - p - 1;                                               \
+        if (n_esq < n / 8 || n_dir < n / 8) {                                           \
+            if (--ruins == 0) {                                                         \
+                nome##_heapsort(v, n);                                                  \
+                return;                                                                 \
+            }                                                                           \
+            if (n_esq >= ORDENACAO_TIPADA_LIMITE_PDQ) {                                 \
+                int q = n_esq / 4;                                                      \
+                t = v[0]; v[0] = v[q]; v[q] = t;                                        \
+                t = v[p - 1]; v[p - 1] = v[p - q]; v[p - q] = t;                        \
+            }                                                                           \
+            if (n_dir >= ORDENACAO_TIPADA_LIMITE_PDQ) {                                 \
+                int q = n_dir / 4;                                                      \
+                t = v[p + 1]; v[p + 1] = v[p + 1 + q]; v[p + 1 + q] = t;                \
+                t = v[n - 1]; v[n - 1] = v[n - q]; v[n - q] = t;                        \
+            }                                                                           \
+        } else if (ja_particionado && nome##_pdq_insertion_parcial(v, p) &&             \
+                   nome##_pdq_insertion_parcial(v + p + 1, n_dir)) {                    \
+            return;                                                                     \
+        }                                                                               \
+        nome##_pdq_laco(v, p, ruins, mais_a_esquerda);                                  \
+        v += p + 1;                                                                     \
+        n = n_dir;                                                                      \
+        mais_a_esquerda = 0;                                                            \
+    }                                                                                   \
+}                                                                                       \
+                                                                                        \
+static inline void nome##_pdqsort(tipo* v, int n) {                                     \
+    if (v == NULL || n <= 1) return;                                                    \
+    int ruins = 0;                                                                      \
+    for (int k = n; k > 1; k >>= 1) ruins++;                                            \
+    nome##_pdq_laco(v, n, ruins, 1);                                                    \
+}
+
+#endif
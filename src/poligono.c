@@ -244,12 +244,194 @@ void poligono_get_vertices(Poligono pol, double** xs, double** ys, int* n) {
     if (n) *n = poligono->num_vertices;
 }
 
+/*==========================*/
+/* Simplificação            */
+/*==========================*/
+
+// Distância máxima de um vértice à aresta dos vizinhos para ser tratado como colinear.
+#define EPSILON_COLINEAR 1e-9
+
+/*
+* Indica se 'b' é dispensável entre 'a' e 'c': repetido de um vizinho ou sobre o
+* segmento ac (a menos de EPSILON_COLINEAR). Pontas que voltam pelo mesmo segmento
+* não são removidas, já que mudariam o contorno.
+*/
+static int vertice_redundante(double ax, double ay, double bx, double by, double cx, double cy) {
+    double abx = bx - ax, aby = by - ay;
+    double acx = cx - ax, acy = cy - ay;
+    double len_sq = acx * acx + acy * acy;
+
+    if (abx * abx + aby * aby <= EPSILON_COLINEAR * EPSILON_COLINEAR) return 1;
+    if ((cx - bx) * (cx - bx) + (cy - by) * (cy - by) <= EPSILON_COLINEAR * EPSILON_COLINEAR) return 1;
+    if (len_sq <= EPSILON_COLINEAR * EPSILON_COLINEAR) return 0;
+
+    double cruz = abx * acy - aby * acx;
+    if (cruz * cruz > EPSILON_COLINEAR * EPSILON_COLINEAR * len_sq) return 0;
+
+    // Dentro do segmento: projeção de b entre a e c
+    double t = abx * acx + aby * acy;
+    return t >= 0 && t <= len_sq;
+}
+
+/*
+* Junta repetidos e colineares em uma passada com pilha: cada vértice novo
+* pode eliminar o último mantido. Depois trata o fechamento (último -> primeiro).
+* Nunca sobram menos de 3 vértices: uma região toda colinear (degenerada) continua
+* sendo desenhada, como sem a simplificação.
+*/
+static void remove_colineares(EstruturaPoligono* p) {
+    double* xs = p->xs;
+    double* ys = p->ys;
+    int n = 0;
+
+    for (int i = 0; i < p->num_vertices; i++) {
+        xs[n] = xs[i];
+        ys[n] = ys[i];
+        n++;
+        // Com o último vértice já na pilha, só remove enquanto restarem mais de 3
+        int minimo = i + 1 < p->num_vertices ? 3 : 4;
+        while (n >= minimo && vertice_redundante(xs[n-3], ys[n-3], xs[n-2], ys[n-2], xs[n-1], ys[n-1])) {
+            xs[n-2] = xs[n-1];
+            ys[n-2] = ys[n-1];
+            n--;
+        }
+    }
+
+    int inicio = 0;
+    int mudou = 1;
+    while (mudou && n - inicio > 3) {
+        mudou = 0;
+        if (vertice_redundante(xs[n-2], ys[n-2], xs[n-1], ys[n-1], xs[inicio], ys[inicio])) {
+            n--;
+            mudou = 1;
+        } else if (vertice_redundante(xs[n-1], ys[n-1], xs[inicio], ys[inicio], xs[inicio+1], ys[inicio+1])) {
+            inicio++;
+            mudou = 1;
+        }
+    }
+
+    if (inicio > 0) {
+        for (int i = inicio; i < n; i++) {
+            xs[i - inicio] = xs[i];
+            ys[i - inicio] = ys[i];
+        }
+        n -= inicio;
+    }
+    p->num_vertices = n;
+}
+
+static double distancia_segmento_sq(double px, double py, double ax, double ay, double bx, double by) {
+    double dx = bx - ax, dy = by - ay;
+    double len_sq = dx * dx + dy * dy;
+    double t = 0;
+    if (len_sq > 0) {
+        t = ((px - ax) * dx + (py - ay) * dy) / len_sq;
+        if (t < 0) t = 0;
+        else if (t > 1) t = 1;
+    }
+    double qx = ax + t * dx - px;
+    double qy = ay + t * dy - py;
+    return qx * qx + qy * qy;
+}
+
+/*
+* Douglas–Peucker no anel: divide no vértice 0 e no mais distante dele, e simplifica
+* as duas cadeias com uma pilha explícita de intervalos (o índice n representa o 0).
+*/
+static void douglas_peucker(EstruturaPoligono* p, double tol) {
+    int n = p->num_vertices;
+    double* xs = p->xs;
+    double* ys = p->ys;
+
+    char* mantem = (char*) calloc((size_t) n + 1, sizeof(char));
+    int* pilha = (int*) malloc(2 * ((size_t) n + 1) * sizeof(int));
+    if (mantem == NULL || pilha == NULL) {
+        printf("Erro ao alocar memoria em poligono_simplifica\n");
+        free(mantem);
+        free(pilha);
+        return;
+    }
+
+    int meio = 1;
+    double maior = -1;
+    for (int i = 1; i < n; i++) {
+        double dx = xs[i] - xs[0], dy = ys[i] - ys[0];
+        double d = dx * dx + dy * dy;
+        if (d > maior) {
+            maior = d;
+            meio = i;
+        }
+    }
+
+    mantem[0] = mantem[meio] = mantem[n] = 1;
+    int topo = 0;
+    pilha[topo++] = 0;    pilha[topo++] = meio;
+    pilha[topo++] = meio; pilha[topo++] = n;
+
+    double tol_sq = tol * tol;
+    while (topo > 0) {
+        int fim = pilha[--topo];
+        int ini = pilha[--topo];
+        int ifim = fim % n;
+
+        int escolhido = -1;
+        double dist_max = tol_sq;
+        for (int i = ini + 1; i < fim; i++) {
+            double d = distancia_segmento_sq(xs[i], ys[i], xs[ini], ys[ini], xs[ifim], ys[ifim]);
+            if (d > dist_max) {
+                dist_max = d;
+                escolhido = i;
+            }
+        }
+        if (escolhido >= 0) {
+            mantem[escolhido] = 1;
+            pilha[topo++] = ini;       pilha[topo++] = escolhido;
+            pilha[topo++] = escolhido; pilha[topo++] = fim;
+        }
+    }
+
+    int restantes = 0;
+    for (int i = 0; i < n; i++) restantes += mantem[i];
+
+    // Um polígono precisa de pelo menos 3 vértices: se sobrar menos, mantém como está
+    if (restantes >= 3) {
+        int k = 0;
+        for (int i = 0; i < n; i++) {
+            if (mantem[i]) {
+                xs[k] = xs[i];
+                ys[k] = ys[i];
+                k++;
+            }
+        }
+        p->num_vertices = k;
+    }
+
+    free(mantem);
+    free(pilha);
+}
+
+int poligono_simplifica(Poligono pol, double tol) {
+    EstruturaPoligono* poligono = (EstruturaPoligono*)pol;
+    if (poligono == NULL) {
+        printf("Erro: poligono nulo em poligono_simplifica\n");
+        return -1;
+    }
+
+    if (poligono->num_vertices > 3) {
+        remove_colineares(poligono);
+    }
+    if (tol > 0 && poligono->num_vertices > 3) {
+        douglas_peucker(poligono, tol);
+    }
+    return poligono->num_vertices;
+}
+
 /*==========================*/
 /* Desenho SVG              */
 /*==========================*/
 
 
-void poligono_desenha_svg(Poligono pol, FILE* svg, char* cor) {
+void poligono_desenha_svg(Poligono pol, EscritorSvg svg, char* cor) {
     EstruturaPoligono* poligono = (EstruturaPoligono*)pol;
     if (poligono == NULL || svg == NULL) {
         printf("Erro em poligono_desenha_svg: poligono ou arquivo nulo\n");
@@ -260,12 +442,18 @@ void poligono_desenha_svg(Poligono pol, FILE* svg, char* cor) {
         return;
     }
 
-    fprintf(svg, "\t<polygon points=\"");
+    svg_escreve_literal(svg, "\t<polygon points=\"");
     
     for (int i = 0; i < poligono->num_vertices; i++) {
-        fprintf(svg, "%.2f,%.2f ", poligono->xs[i], poligono->ys[i]);
+        svg_escreve_numero(svg, poligono->xs[i], 2);
+        svg_escreve_literal(svg, ",");
+        svg_escreve_numero(svg, poligono->ys[i], 2);
+        svg_escreve_literal(svg, " ");
     }
     
-    fprintf(svg, "\" fill=\"%s\" fill-opacity=\"0.3\" stroke=\"%s\" stroke-width=\"2\" />\n", 
-            cor, cor);
+    svg_escreve_literal(svg, "\" fill=\"");
+    svg_escreve_texto(svg, cor);
+    svg_escreve_literal(svg, "\" fill-opacity=\"0.3\" stroke=\"");
+    svg_escreve_texto(svg, cor);
+    svg_escreve_literal(svg, "\" stroke-width=\"2\" />\n");
 }
\ No newline at end of file
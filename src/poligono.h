@@ -2,6 +2,7 @@
 #define POLIGONO_H
 
 #include <stdio.h>
+#include "svg.h"
 
 typedef void* Poligono;
 
@@ -58,6 +59,31 @@ int poligono_contem_ponto(Poligono pol, double px, double py);
  */
 void poligono_get_vertices(Poligono pol, double** xs, double** ys, int* n);
 
+/**
+ * @brief Calcula a caixa envolvente do polígono.
+ * @param pol Polígono.
+ * @param xmin, ymin, xmax, ymax Onde escrever os limites (0 se o polígono for vazio).
+ */
+void poligono_bounding_box(Poligono pol, double* xmin, double* ymin,
+                           double* xmax, double* ymax);
+
+/*========================*/
+/* Simplificação          */
+/*========================*/
+
+/**
+ * @brief Remove vértices redundantes do polígono, no lugar.
+ * Sempre junta vértices repetidos e sequências colineares (o vértice do meio está sobre
+ * a aresta entre os vizinhos, a menos de 1e-9), o que move o contorno no máximo isso.
+ * Nunca deixa menos de 3 vértices.
+ * Com tolerância positiva aplica também Douglas–Peucker: descarta vértices que distam
+ * no máximo 'tol' da aresta simplificada, alterando a região em até 'tol'.
+ * @param pol Polígono.
+ * @param tol Tolerância do Douglas–Peucker (0 para só juntar colineares).
+ * @return int Número de vértices após a simplificação.
+ */
+int poligono_simplifica(Poligono pol, double tol);
+
 /*========================*/
 /* Desenho                */
 /*========================*/
@@ -65,9 +91,9 @@ void poligono_get_vertices(Poligono pol, double** xs, double** ys, int* n);
 /**
  * @brief Desenha o polígono em um arquivo SVG.
  * @param pol Polígono.
- * @param svg Arquivo SVG aberto.
+ * @param svg Escritor do arquivo SVG aberto.
  * @param cor Cor de preenchimento do polígono.
  */
-void poligono_desenha_svg(Poligono pol, FILE* svg, char* cor);
+void poligono_desenha_svg(Poligono pol, EscritorSvg svg, char* cor);
 
 #endif
\ No newline at end of file
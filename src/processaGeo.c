@@ -1,12 +1,204 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "processaGeo.h"
 #include "lista.h" 
 #include "formas.h" 
 #include "estilo.h"
+#include "cores.h"
+#include "leitor.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+// Textos até esse tamanho são montados na pilha; maiores são alocados.
+#define TAM_TEXTO_LOCAL 128
+
+// Abaixo desse tamanho por thread, a leitura fica em uma thread só.
+#define MIN_BYTES_POR_THREAD (1 << 20)
+
+/*
+* Estado de estilo de texto (comando 'ts'). Ele é posicional: vale para os 't' seguintes.
+* Cada 'ts' vira um único Estilo compartilhado, e os textos seguintes só ganham uma
+* referência a ele. As referências dos textos são só contadas no trecho (sem a trava
+* dos estilos) e acrescentadas de uma vez: no próximo 'ts' ou depois do join; até lá o
+* trecho mantém a sua própria referência, e o estilo não pode ser liberado. Cada trecho começa sem saber o estilo vigente: os textos lidos antes
+* do primeiro 'ts' do trecho dividem um estilo provisório, preenchido depois com o
+* estilo final dos trechos anteriores.
+*/
+typedef struct {
+    char fFamily[32];
+    char fWeight[8];
+    double fSize;
+    int definido;            // 1 se um 'ts' já apareceu neste trecho
+    Estilo estilo;           // Estilo compartilhado do último 'ts' (NULL se não houve)
+    int pendentes;           // Textos que usam 'estilo' e ainda não contam como referência
+} EstadoTexto;
+
+// Trecho do arquivo lido por uma thread
+typedef struct {
+    CursorTexto cursor;
+    Lista formas;
+    EstadoTexto estado;
+    Estilo provisorio;       // Estilo dos textos anteriores ao primeiro 'ts' do trecho
+    int pendentes_provisorio; // Textos que usam 'provisorio' e ainda não contam como referência
+    CargaFormas carga;       // Memória das formas do trecho, juntada à cena após o join
+} TrechoGeo;
+
+static void estado_inicia_padrao(EstadoTexto* estado) {
+    strcpy(estado->fFamily, "sans");
+    strcpy(estado->fWeight, "n");
+    estado->fSize = 10;
+    estado->definido = 0;
+    estado->estilo = NULL;
+    estado->pendentes = 0;
+}
+
+// Estilo para o próximo texto do trecho (a referência fica pendente no trecho)
+static Estilo estilo_do_texto(TrechoGeo* trecho) {
+    EstadoTexto* estado = &trecho->estado;
+    if (estado->definido) {
+        estado->pendentes++;
+        return estado->estilo;
+    }
+    if (trecho->provisorio == NULL) {
+        trecho->provisorio = estilo_cria(estado->fFamily, estado->fWeight, estado->fSize);
+    }
+    trecho->pendentes_provisorio++;
+    return trecho->provisorio;
+}
+
+// Interpreta uma linha do .geo, adicionando a forma criada (se houver) ao trecho
+static void processa_linha(TrechoGeo* trecho, CursorTexto* linha) {
+    char comando[16];
+    EstadoTexto* estado = &trecho->estado;
+    Lista lista_formas = trecho->formas;
+
+    if (linha->p == linha->fim || linha->p[0] == '#') {
+        return;
+    }
+
+    if (!cursor_le_palavra(linha, comando, sizeof(comando))) {
+        return;
+    }
+
+    if (strcmp(comando, "c") == 0) {
+        int id; 
+        double x, y, r; 
+        char corb[32] = "", corp[32] = "";
+        if (!cursor_le_int(linha, &id) || !cursor_le_double(linha, &x) ||
+            !cursor_le_double(linha, &y) || !cursor_le_double(linha, &r)) return;
+        if (cursor_le_palavra(linha, corb, sizeof(corb))) {
+            cursor_le_palavra(linha, corp, sizeof(corp));
+        }
+        Forma f = circulo_cria(id, x, y, r, corb, corp);
+        lista_adiciona(lista_formas, f);
+    }
+    else if (strcmp(comando, "r") == 0) {
+        int id;
+        double x, y, w, h;
+        char corb[32] = "", corp[32] = "";
+        if (!cursor_le_int(linha, &id) || !cursor_le_double(linha, &x) ||
+            !cursor_le_double(linha, &y) || !cursor_le_double(linha, &w) ||
+            !cursor_le_double(linha, &h)) return;
+        if (cursor_le_palavra(linha, corb, sizeof(corb))) {
+            cursor_le_palavra(linha, corp, sizeof(corp));
+        }
+        Forma f = retangulo_cria(id, x, y, w, h, corb, corp);
+        lista_adiciona(lista_formas, f);
+    }
+    else if (strcmp(comando, "l") == 0) {
+        int id; double x1, y1, x2, y2; char cor[64] = "";
+        if (!cursor_le_int(linha, &id) || !cursor_le_double(linha, &x1) ||
+            !cursor_le_double(linha, &y1) || !cursor_le_double(linha, &x2) ||
+            !cursor_le_double(linha, &y2)) return;
+        cursor_le_palavra(linha, cor, sizeof(cor));
+        Forma f = linha_cria(id, x1, y1, x2, y2, cor);
+        lista_adiciona(lista_formas, f);
+    }
+    else if (strcmp(comando, "t") == 0) {
+        int id = 0;
+        double x = 0, y = 0;
+        char corp[32] = "", corb[32] = "";
+        char a = 'i';
+        char txto_local[TAM_TEXTO_LOCAL] = "";
+        char *txto = txto_local;
+
+        // O texto é o resto da linha, sem limite de tamanho
+        if (cursor_le_int(linha, &id) && cursor_le_double(linha, &x) &&
+            cursor_le_double(linha, &y) && cursor_le_palavra(linha, corb, sizeof(corb)) &&
+            cursor_le_palavra(linha, corp, sizeof(corp)) && cursor_le_char(linha, &a)) {
+            cursor_pula_espacos(linha);
+            const char *cr = memchr(linha->p, '\r', (size_t)(linha->fim - linha->p));
+            size_t len = (size_t)((cr != NULL ? cr : linha->fim) - linha->p);
+            if (len >= sizeof(txto_local)) {
+                txto = (char*) malloc(len + 1);
+                if (txto == NULL) {
+                    printf("Erro ao alocar texto em processaGeo\n");
+                    return;
+                }
+            }
+            memcpy(txto, linha->p, len);
+            txto[len] = '\0';
+        }
+
+        Forma f = texto_cria(id, x, y, corb, corp, a, txto, estilo_do_texto(trecho));
+        lista_adiciona(lista_formas, f);
+        if (txto != txto_local) {
+            free(txto);
+        }
+    }
+    else if (strcmp(comando, "ts") == 0) {
+        char family[32], weight[8];
+        double size;
+        if (cursor_le_palavra(linha, family, sizeof(family)) &&
+            cursor_le_palavra(linha, weight, sizeof(weight)) &&
+            cursor_le_double(linha, &size)) {
+            strcpy(estado->fFamily, family);
+            strcpy(estado->fWeight, weight);
+            estado->fSize = size;
+            estado->definido = 1;
+            estilo_acrescenta_referencias(estado->estilo, estado->pendentes);
+            estilo_destroi(estado->estilo);
+            estado->estilo = estilo_interna(family, weight, size);
+            estado->pendentes = 0;
+        }
+    }
+}
+
+// Lê um trecho com arena, cache de cores e contagem de estilos próprios: só cores novas
+// e comandos 'ts' passam pelas travas globais
+static void* processa_trecho(void* arg) {
+    TrechoGeo* trecho = (TrechoGeo*) arg;
+    CursorTexto linha;
+
+    formas_inicia_carga();
+    cores_inicia_cache();
+    while (cursor_proxima_linha(&trecho->cursor, &linha)) {
+        processa_linha(trecho, &linha);
+    }
+    cores_encerra_cache();
+    trecho->carga = formas_encerra_carga();
+
+    return NULL;
+}
+
+// Número de threads usado por processaGeo: núcleos disponíveis, limitado pelo tamanho do arquivo
+static int threads_automaticas(size_t tamanho) {
+    long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t por_tamanho = tamanho / MIN_BYTES_POR_THREAD;
+    if (nucleos < 1) nucleos = 1;
+    if (por_tamanho < (size_t)nucleos) nucleos = (long)por_tamanho;
+    return nucleos < 1 ? 1 : (int)nucleos;
+}
 
 Lista processaGeo(const char *path_geo) {
-    FILE *arquivo_geo = fopen(path_geo, "r");
+    return processaGeo_paralelo(path_geo, 0);
+}
+
+Lista processaGeo_paralelo(const char *path_geo, int n_threads) {
+    ArquivoMapeado arquivo_geo = arquivo_mapeia(path_geo);
     if (arquivo_geo == NULL) {
         printf("erro ao abrir arquivo geo\n");
         return NULL;
@@ -14,88 +206,93 @@ Lista processaGeo(const char *path_geo) {
 
     Lista lista_formas = lista_cria();
     if (lista_formas == NULL) {
-        fclose(arquivo_geo);
+        arquivo_libera(arquivo_geo);
         return NULL;
     }
 
-    char buffer[256];
-    char comando[16];
-    char fFamily[32] = "sans";
-    char fWeight[8] = "n";
-    double fSize = 10; 
+    const char *dados = arquivo_dados(arquivo_geo);
+    size_t tamanho = arquivo_tamanho(arquivo_geo);
 
-    while (fgets(buffer, sizeof(buffer), arquivo_geo) != NULL) {
-        if (buffer[0] == '\n' || buffer[0] == '#') {
-            continue;
-        }
+    if (n_threads <= 0) {
+        n_threads = threads_automaticas(tamanho);
+    }
+    if ((size_t)n_threads > tamanho) {
+        n_threads = tamanho > 0 ? (int)tamanho : 1;
+    }
+
+    TrechoGeo *trechos = (TrechoGeo*) calloc((size_t)n_threads, sizeof(TrechoGeo));
+    pthread_t *threads = (pthread_t*) malloc((size_t)n_threads * sizeof(pthread_t));
+    int *criada = (int*) calloc((size_t)n_threads, sizeof(int));
+    if (trechos == NULL || threads == NULL || criada == NULL) {
+        printf("Erro ao alocar trechos em processaGeo\n");
+        free(trechos);
+        free(threads);
+        free(criada);
+        lista_destruir(lista_formas);
+        arquivo_libera(arquivo_geo);
+        return NULL;
+    }
 
-        comando[0] = '\0';
-        sscanf(buffer, "%s", comando);
-
-        if (strcmp(comando, "c") == 0) {
-            int id; 
-            double x, y, r; 
-            char corb[32] = "", corp[32] = "";
-            int n_lidos = sscanf(buffer, "c %i %lf %lf %lf %s %s", &id, &x, &y, &r, corb, corp);
-            if (n_lidos < 4) continue;
-            Forma f = circulo_cria(id, x, y, r, corb, corp);
-            lista_adiciona(lista_formas, f);
+    // Divide o arquivo em trechos que terminam logo após um '\n'
+    size_t inicio = 0;
+    for (int i = 0; i < n_threads; i++) {
+        size_t fim = (i == n_threads - 1) ? tamanho : tamanho / n_threads * (i + 1);
+        if (fim < inicio) {
+            fim = inicio;
         }
-        else if (strcmp(comando, "r") == 0) {
-            int id;
-            double x, y, w, h;
-            char corb[32] = "", corp[32] = "";
-            int n_lidos = sscanf(buffer, "r %i %lf %lf %lf %lf %s %s", &id, &x, &y, &w, &h, corb, corp);
-            if (n_lidos < 5) continue;
-            Forma f = retangulo_cria(id, x, y, w, h, corb, corp);
-            lista_adiciona(lista_formas, f);
+        if (fim < tamanho) {
+            const char *quebra = memchr(dados + fim, '\n', tamanho - fim);
+            fim = quebra != NULL ? (size_t)(quebra - dados) + 1 : tamanho;
         }
-        else if (strcmp(comando, "l") == 0) {
-            int id; double x1, y1, x2, y2; char cor[64] = "";
-            int n_lidos = sscanf(buffer, "l %i %lf %lf %lf %lf %s", &id, &x1, &y1, &x2, &y2, cor);
-            if (n_lidos < 5) continue;
-            Forma f = linha_cria(id, x1, y1, x2, y2, cor);
-            lista_adiciona(lista_formas, f);
+        cursor_inicia(&trechos[i].cursor, dados + inicio, fim - inicio);
+        trechos[i].formas = lista_cria();
+        estado_inicia_padrao(&trechos[i].estado);
+        inicio = fim;
+    }
+
+    // O primeiro trecho fica com a thread chamadora; se uma thread não puder ser criada,
+    // o trecho dela é lido depois, na thread chamadora
+    for (int i = 1; i < n_threads; i++) {
+        criada[i] = pthread_create(&threads[i], NULL, processa_trecho, &trechos[i]) == 0;
+    }
+    processa_trecho(&trechos[0]);
+    for (int i = 1; i < n_threads; i++) {
+        if (criada[i]) {
+            pthread_join(threads[i], NULL);
+        } else {
+            processa_trecho(&trechos[i]);
         }
-        else if (strcmp(comando, "t") == 0) {
-            int id;
-            double x, y;
-            char corp[32] = "", corb[32] = "";
-            char a = 'i';
-            char txto[128] = "";
-            int offset = 0;
-
-            sscanf(buffer, "t %i %lf %lf %s %s %c %n", &id, &x, &y, corb, corp, &a, &offset);
-
-            if (offset > 0) {
-                const char *inicio_texto = buffer + offset;
-                while (*inicio_texto && (*inicio_texto == ' ' || *inicio_texto == '\t')) {
-                    inicio_texto++;
-                }
-                strncpy(txto, inicio_texto, sizeof(txto) - 1);
-                txto[sizeof(txto) - 1] = '\0';
-                txto[strcspn(txto, "\r\n")] = 0;
-            }
+    }
 
-            Estilo estilo_temp = estilo_cria(fFamily, fWeight, fSize);
-            Forma f = texto_cria(id, x, y, corb, corp, a, txto, estilo_temp);
-            lista_adiciona(lista_formas, f);
+    // Resolve os estilos pendentes em ordem de arquivo e junta as listas
+    EstadoTexto vigente;
+    estado_inicia_padrao(&vigente);
+    for (int i = 0; i < n_threads; i++) {
+        TrechoGeo *trecho = &trechos[i];
+        if (trecho->provisorio != NULL) {
+            estilo_setFamily(trecho->provisorio, vigente.fFamily);
+            estilo_setWeight(trecho->provisorio, vigente.fWeight);
+            estilo_setSize(trecho->provisorio, vigente.fSize);
+            estilo_acrescenta_referencias(trecho->provisorio, trecho->pendentes_provisorio);
+            estilo_destroi(trecho->provisorio);
         }
-        else if (strcmp(comando, "ts") == 0) {
-            char family[32], weight[8];
-            double size;
-            int n_lidos = sscanf(buffer, "ts %s %s %lf", family, weight, &size);
-            if (n_lidos == 3) {
-                strcpy(fFamily, family);
-                strcpy(fWeight, weight);
-                fSize = size;
-            }
+        if (trecho->estado.definido) {
+            vigente = trecho->estado;
         }
+        // Os textos passam a ser donos do estilo; o trecho solta a sua referência
+        estilo_acrescenta_referencias(trecho->estado.estilo, trecho->estado.pendentes);
+        estilo_destroi(trecho->estado.estilo);
+        formas_junta_carga(trecho->carga);
+        lista_concatena(lista_formas, trecho->formas);
+        lista_destruir(trecho->formas);
     }
 
     int num_formas = lista_tamanho(lista_formas);
     printf("DEBUG processaGeo: %d formas criadas e adicionadas\n", num_formas);
     
-    fclose(arquivo_geo);
+    free(trechos);
+    free(threads);
+    free(criada);
+    arquivo_libera(arquivo_geo);
     return lista_formas;
-}
\ No newline at end of file
+}
@@ -20,4 +20,16 @@
  */
 Lista processaGeo(const char *path_geo);
 
+/**
+ * @brief Processa o arquivo geo dividindo-o em trechos lidos em paralelo.
+ * O arquivo é cortado em quebras de linha; cada thread lê seu trecho em uma lista
+ * própria e as listas são concatenadas na ordem do arquivo. Textos lidos antes do
+ * primeiro 'ts' de um trecho recebem o estilo vigente ao final dos trechos anteriores,
+ * então o resultado é o mesmo da leitura sequencial.
+ * @param path_geo Caminho do arquivo geo.
+ * @param n_threads Número de trechos/threads (<= 0 escolhe pelo número de núcleos e tamanho do arquivo).
+ * @return Lista A lista de formas, ou NULL em caso de erro.
+ */
+Lista processaGeo_paralelo(const char *path_geo, int n_threads);
+
 #endif
\ No newline at end of file
@@ -1,267 +1,481 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include "lista.h"
 #include "formas.h"
 #include "anteparo.h"
 #include "visibilidade.h"
 #include "svg.h"
+#include "programaQry.h"
+#include "saida.h"
+#include "tabelaFormas.h"
+#include "estatisticas.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+// Máximo de bombas seguidas cujas regiões de visibilidade são calculadas juntas.
+#define MAX_LOTE_BOMBAS 64
+
+// Tolerância do Douglas–Peucker nos contornos desenhados das regiões (0: só junta vértices colineares).
+#ifndef TOLERANCIA_SIMPLIFICACAO
+#define TOLERANCIA_SIMPLIFICACAO 0.0
+#endif
+
+/*
+* Estado do interpretador. Os anteparos ficam em um conjunto (arrays paralelos) que os
+* comandos 'a' aumentam e que a visibilidade lê direto. Entre dois 'a' ele não muda,
+* então o desenho é feito uma vez por versão: cada versão vira um grupo no <defs> do svg,
+* e cada bomba só referencia o grupo com <use>.
+* As bombas consultam as formas pela tabela colunar, que acompanha a lista: clones são
+* acrescentados e formas destruídas marcadas nela. O comando 'a' a invalida (NULL).
+* Com --stats, cada comando vira um registro em 'est' (NULL quando desligado).
+*/
+typedef struct {
+    Lista formas;
+    TabelaFormas tabela;     // Mesmas formas da lista, em colunas (NULL: remontar)
+    ConjuntoAnteparos anteparos;
+    int versao_anteparos;    // Versão desenhada no grupo abaixo (-1 se nenhuma)
+    char grupo_anteparos[32];  // Id do grupo svg da versão atual ("" se não há anteparos)
+    EscritorSvg svg;
+    Saida txt;
+    Estatisticas est;
+} EstadoQry;
+
+// Tarefa de uma thread no cálculo de um lote: bombas inicio, inicio + passo, ...
+typedef struct {
+    const EstadoQry* estado;
+    const ComandoQry** bombas;
+    Poligono* regioes;
+    Poligono* contornos;               // Cópias simplificadas das regiões, só para o desenho
+    double* tempos;                    // Tempo de cada região (só com estatísticas)
+    ContagemVisibilidade* contagens;   // Trabalho de cada região (só com estatísticas)
+    int n, inicio, passo;
+} TarefaLote;
+
+static void prepara_anteparos(EstadoQry* estado, int versao) {
+    if (estado->versao_anteparos == versao) {
+        return;
+    }
+    estado->versao_anteparos = versao;
+    
+    // Desenha os anteparos da versão uma única vez
+    estado->grupo_anteparos[0] = '\0';
+    if (conjunto_anteparos_tamanho(estado->anteparos) > 0) {
+        snprintf(estado->grupo_anteparos, sizeof(estado->grupo_anteparos), "anteparos-%d", versao);
+        svg_abre_grupo(estado->svg, estado->grupo_anteparos);
+        conjunto_anteparos_desenha_svg(estado->anteparos, estado->svg);
+        svg_fecha_grupo(estado->svg);
+    }
+}
+
+// Comando 'a': Transformar forma em anteparo
+static void executa_anteparo(EstadoQry* estado, const ComandoQry* cmd) {
+    int id_min = cmd->id_min, id_max = cmd->id_max;
+    char orient = cmd->orientacao;
+    
+    saida_printf(estado->txt, "[*] a %d %d %c\n", id_min, id_max, orient);
+    estatisticas_marca(estado->est, FASE_SAIDA);
+    
+    // Cria lista temporária de formas a remover
+    Lista formas_remover = lista_cria();
+    
+    // Percorre formas e transforma em anteparos
+    int n;
+    void** array = lista_para_array(estado->formas, &n);
+    if (array != NULL) {
+        for (int i = 0; i < n; i++) {
+            Forma f = (Forma)array[i];
+            int id = forma_getId(f);
+            
+            if (id >= id_min && id <= id_max) {
+                // Acrescenta os anteparos da forma ao conjunto
+                forma_para_anteparos(f, orient, estado->anteparos);
+                lista_adiciona(formas_remover, f);
+                estatisticas_marca(estado->est, FASE_MUTACAO);
+                
+                saida_printf(estado->txt, "Forma %d transformada em anteparo\n", id);
+                estatisticas_marca(estado->est, FASE_SAIDA);
+                estatisticas_soma(estado->est, CONT_FORMAS_ATINGIDAS, 1);
+            }
+        }
+        free(array);
+    }
+    
+    // Remove e destroi as formas depois do loop
+    int n_rem;
+    void** arr_rem = lista_para_array(formas_remover, &n_rem);
+    if (arr_rem != NULL) {
+        for (int i = 0; i < n_rem; i++) {
+            Forma f = (Forma)arr_rem[i];
+            lista_retira(estado->formas, f);
+            forma_destroi(f);
+        }
+        free(arr_rem);
+    }
+    lista_destruir(formas_remover);
+    
+    if (n_rem > 0) {
+        tabela_formas_destroi(estado->tabela);
+        estado->tabela = NULL;
+    }
+    estatisticas_marca(estado->est, FASE_MUTACAO);
+}
+
+static void desenha_anteparos(EstadoQry* estado) {
+    if (estado->grupo_anteparos[0] != '\0') {
+        svg_usa_grupo(estado->svg, estado->grupo_anteparos);
+    }
+}
+
+/*
+* Formas que sobrepõem a região, na ordem da lista. A tabela filtra pela caixa envolvente
+* (calculada uma vez por bomba, e não uma vez por forma) e só as candidatas passam pelo
+* teste detalhado. As atingidas são juntadas no começo do próprio array da consulta.
+*/
+static RefFormaTabela* formas_atingidas(EstadoQry* estado, Poligono vis, int* n) {
+    if (estado->tabela == NULL) {
+        estado->tabela = tabela_formas_cria(estado->formas);
+    }
+    double xmin, ymin, xmax, ymax;
+    poligono_bounding_box(vis, &xmin, &ymin, &xmax, &ymax);
+    
+    int n_candidatas;
+    RefFormaTabela* refs = tabela_formas_candidatas(estado->tabela, xmin, ymin, xmax, ymax, &n_candidatas);
+    int k = 0;
+    for (int i = 0; i < n_candidatas; i++) {
+        if (forma_sobrepoe_visibilidade_candidata(refs[i].forma, vis)) {
+            refs[k++] = refs[i];
+        }
+    }
+    
+    estatisticas_soma(estado->est, CONT_FORMAS_TESTADAS, n_candidatas);
+    estatisticas_soma(estado->est, CONT_FORMAS_ATINGIDAS, k);
+    estatisticas_marca(estado->est, FASE_SOBREPOSICAO);
+    *n = k;
+    return refs;
+}
+
+// Comando 'd': Bomba de destruição
+static void executa_destruicao(EstadoQry* estado, const ComandoQry* cmd, Poligono vis, Poligono contorno) {
+    saida_printf(estado->txt, "[*] d %.2f %.2f\n", cmd->x, cmd->y);
+    
+    // Desenha anteparos primeiro
+    desenha_anteparos(estado);
+    svg_desenha_asterisco(estado->svg, cmd->x, cmd->y);
+    
+    if (vis == NULL) {
+        return;
+    }
+    
+    // Desenha região de visibilidade
+    poligono_desenha_svg(contorno != NULL ? contorno : vis, estado->svg, "#FF6B6B");
+    
+    estatisticas_marca(estado->est, FASE_SAIDA);
+    
+    // Remove as formas dentro da região (a consulta já é uma cópia)
+    int n;
+    RefFormaTabela* atingidas = formas_atingidas(estado, vis, &n);
+    for (int i = 0; i < n; i++) {
+        Forma f = atingidas[i].forma;
+        saida_printf(estado->txt, "Destruída: forma %d\n", forma_getId(f));
+        estatisticas_marca(estado->est, FASE_SAIDA);
+        tabela_formas_remove(estado->tabela, atingidas[i]);
+        lista_retira(estado->formas, f);
+        forma_destroi(f);
+        estatisticas_marca(estado->est, FASE_MUTACAO);
+    }
+}
+
+// Comando 'p': Bomba de pintura
+static void executa_pintura(EstadoQry* estado, const ComandoQry* cmd, Poligono vis, Poligono contorno) {
+    saida_printf(estado->txt, "[*] p %.2f %.2f %s\n", cmd->x, cmd->y, cmd->cor);
+    
+    // Desenha anteparos
+    desenha_anteparos(estado);
+    
+    if (vis == NULL) {
+        return;
+    }
+    
+    poligono_desenha_svg(contorno != NULL ? contorno : vis, estado->svg, "#4ECDC4");
+    
+    estatisticas_marca(estado->est, FASE_SAIDA);
+    
+    // Pinta formas dentro da região
+    int n;
+    RefFormaTabela* atingidas = formas_atingidas(estado, vis, &n);
+    for (int i = 0; i < n; i++) {
+        Forma f = atingidas[i].forma;
+        saida_printf(estado->txt, "Pintada: forma %d\n", forma_getId(f));
+        estatisticas_marca(estado->est, FASE_SAIDA);
+        forma_pinta(f, cmd->id_cor);
+        estatisticas_marca(estado->est, FASE_MUTACAO);
+    }
+}
+
+// Comando 'cln': Bomba de clonagem
+static void executa_clonagem(EstadoQry* estado, const ComandoQry* cmd, Poligono vis, Poligono contorno) {
+    saida_printf(estado->txt, "[*] cln %.2f %.2f %.2f %.2f\n", cmd->x, cmd->y, cmd->dx, cmd->dy);
+    
+    // Desenha anteparos
+    desenha_anteparos(estado);
+    
+    if (vis == NULL) {
+        return;
+    }
+    
+    poligono_desenha_svg(contorno != NULL ? contorno : vis, estado->svg, "#95E1D3");
+    
+    estatisticas_marca(estado->est, FASE_SAIDA);
+    
+    // Clona formas dentro da região (os clones vão para o fim da lista e da tabela)
+    int n;
+    RefFormaTabela* atingidas = formas_atingidas(estado, vis, &n);
+    for (int i = 0; i < n; i++) {
+        Forma f = atingidas[i].forma;
+        Forma clone = forma_clonar(f, cmd->dx, cmd->dy);
+        if (clone != NULL) {
+            lista_adiciona(estado->formas, clone);
+            tabela_formas_adiciona(estado->tabela, clone);
+            estatisticas_marca(estado->est, FASE_MUTACAO);
+            saida_printf(estado->txt, "Clonada: forma %d como %d\n", 
+                    forma_getId(f), forma_getId(clone));
+            estatisticas_marca(estado->est, FASE_SAIDA);
+        }
+    }
+}
 
-void processaQry(const char *path_qry, Lista formas, const char *path_svg_saida, const char *path_txt_saida) {
+/*
+* Cópia simplificada da região, usada só no svg (menos vértices, arquivo menor). A
+* sobreposição continua testada na região original: juntar vértices, mesmo exatamente
+* colineares, muda os casos de borda do teste e com isso as formas atingidas.
+*/
+static Poligono contorno_simplificado(Poligono regiao) {
+    if (regiao == NULL) return NULL;
+    Poligono contorno = poligono_cria();
+    if (contorno == NULL) return NULL;
     
-    FILE *arquivo_qry = fopen(path_qry, "r");
-    if (arquivo_qry == NULL) {
+    double *xs, *ys;
+    int n;
+    poligono_get_vertices(regiao, &xs, &ys, &n);
+    for (int i = 0; i < n; i++) {
+        poligono_adiciona_vertice(contorno, xs[i], ys[i]);
+    }
+    poligono_simplifica(contorno, TOLERANCIA_SIMPLIFICACAO);
+    return contorno;
+}
+
+static void* calcula_regioes_lote(void* arg) {
+    TarefaLote* t = (TarefaLote*) arg;
+    for (int k = t->inicio; k < t->n; k += t->passo) {
+        if (!t->bombas[k]->repete_origem || k == 0) {
+            double inicio = t->tempos != NULL ? estatisticas_relogio() : 0;
+            t->regioes[k] = calcula_regiao_visibilidade_conjunto(t->bombas[k]->x, t->bombas[k]->y,
+                                                                 t->estado->anteparos,
+                                                                 t->contagens != NULL ? &t->contagens[k] : NULL);
+            t->contornos[k] = contorno_simplificado(t->regioes[k]);
+            if (t->tempos != NULL) {
+                t->tempos[k] = estatisticas_relogio() - inicio;
+            }
+        }
+    }
+    return NULL;
+}
+
+/*
+* Calcula as regiões de visibilidade de um lote de bombas seguidas. Elas dependem só da
+* origem e dos anteparos (que nenhuma bomba altera), então podem ser calculadas antes de
+* aplicar os efeitos e em paralelo. Origens repetidas reaproveitam a região anterior.
+*/
+static void calcula_lote(EstadoQry* estado, const ComandoQry** bombas, Poligono* regioes,
+                         Poligono* contornos, double* tempos, ContagemVisibilidade* contagens, int n) {
+    long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+    int n_threads = nucleos < 1 ? 1 : (nucleos > n ? n : (int)nucleos);
+    
+    TarefaLote tarefas[MAX_LOTE_BOMBAS];
+    pthread_t threads[MAX_LOTE_BOMBAS];
+    int criada[MAX_LOTE_BOMBAS] = {0};
+    
+    for (int t = 0; t < n_threads; t++) {
+        tarefas[t].estado = estado;
+        tarefas[t].bombas = bombas;
+        tarefas[t].regioes = regioes;
+        tarefas[t].contornos = contornos;
+        tarefas[t].tempos = tempos;
+        tarefas[t].contagens = contagens;
+        tarefas[t].n = n;
+        tarefas[t].inicio = t;
+        tarefas[t].passo = n_threads;
+    }
+    
+    // A primeira tarefa fica com a thread chamadora
+    for (int t = 1; t < n_threads; t++) {
+        criada[t] = pthread_create(&threads[t], NULL, calcula_regioes_lote, &tarefas[t]) == 0;
+    }
+    calcula_regioes_lote(&tarefas[0]);
+    for (int t = 1; t < n_threads; t++) {
+        if (criada[t]) {
+            pthread_join(threads[t], NULL);
+        } else {
+            calcula_regioes_lote(&tarefas[t]);
+        }
+    }
+    
+    for (int k = 1; k < n; k++) {
+        if (bombas[k]->repete_origem) {
+            regioes[k] = regioes[k - 1];
+            contornos[k] = contornos[k - 1];
+        }
+    }
+}
+
+static const char* nome_comando(TipoComandoQry tipo) {
+    switch (tipo) {
+        case QRY_ANTEPARO:   return "a";
+        case QRY_DESTRUICAO: return "d";
+        case QRY_PINTURA:    return "p";
+        case QRY_CLONAGEM:   return "cln";
+    }
+    return "?";
+}
+
+// Formas alocadas até agora (só consultado com estatísticas ligadas)
+static long long alocacoes_ate_agora(Estatisticas est) {
+    long long alocacoes = 0;
+    if (est != NULL) {
+        formas_uso_cena(&alocacoes, NULL);
+    }
+    return alocacoes;
+}
+
+/*
+* Fecha o registro do comando com as formas alocadas desde 'alocacoes_antes'
+* e o tamanho da cena.
+*/
+static void fecha_registro_comando(EstadoQry* estado, long long alocacoes_antes) {
+    if (estado->est == NULL) return;
+    estatisticas_marca(estado->est, FASE_SAIDA);
+    estatisticas_soma(estado->est, CONT_ALOCACOES, alocacoes_ate_agora(estado->est) - alocacoes_antes);
+    estatisticas_fecha_registro(estado->est, lista_tamanho(estado->formas));
+}
+
+void processaQry(const char *path_qry, Lista formas, const char *path_svg_saida, const char *path_txt_saida,
+                 int svg_comprimido, int txt_comprimido, Estatisticas est) {
+    
+    ProgramaQry programa = programa_qry_compila(path_qry);
+    if (programa == NULL) {
         printf("Erro ao abrir arquivo .qry: %s\n", path_qry);
         return;
     }
     
-    FILE *svg_saida = svg_inicia(path_svg_saida);
-    FILE *txt_saida = fopen(path_txt_saida, "w");
+    EscritorSvg svg_saida = svg_inicia(path_svg_saida, svg_comprimido);
+    Saida txt_saida = saida_abre(path_txt_saida, txt_comprimido);
     
     if (svg_saida == NULL || txt_saida == NULL) {
         printf("Erro ao criar arquivos de saída\n");
-        fclose(arquivo_qry);
+        if (svg_saida != NULL) svg_finaliza(svg_saida);
+        if (txt_saida != NULL) saida_fecha(txt_saida);
+        programa_qry_destroi(programa);
         return;
     }
     
-    char buffer[512];
-    char comando[16];
-    Lista anteparos = lista_cria();
+    EstadoQry estado;
+    estado.formas = formas;
+    estado.tabela = NULL;
+    estado.anteparos = conjunto_anteparos_cria();
+    estado.versao_anteparos = -1;
+    estado.grupo_anteparos[0] = '\0';
+    estado.svg = svg_saida;
+    estado.txt = txt_saida;
+    estado.est = est;
     
-    while (fgets(buffer, sizeof(buffer), arquivo_qry) != NULL) {
-        // Ignora linhas vazias e comentários
-        if (buffer[0] == '\n' || buffer[0] == '#') {
+    int n_comandos = programa_qry_tamanho(programa);
+    int i = 0;
+    while (i < n_comandos) {
+        const ComandoQry* cmd = programa_qry_comando(programa, i);
+        
+        if (cmd->tipo == QRY_ANTEPARO) {
+            long long alocacoes = alocacoes_ate_agora(est);
+            estatisticas_abre_registro(est, nome_comando(cmd->tipo), i);
+            executa_anteparo(&estado, cmd);
+            fecha_registro_comando(&estado, alocacoes);
+            i++;
             continue;
         }
         
-        comando[0] = '\0';
-        sscanf(buffer, "%s", comando);
-        
-        // Comando 'a': Transformar forma em anteparo
-        if (strcmp(comando, "a") == 0) {
-            int id_min, id_max;
-            char orientacao[8] = "h";
-            sscanf(buffer, "a %d %d %s", &id_min, &id_max, orientacao);
-            
-            char orient = orientacao[0];
-            
-            fprintf(txt_saida, "[*] a %d %d %c\n", id_min, id_max, orient);
-            
-            // Cria lista temporária de formas a remover
-            Lista formas_remover = lista_cria();
-            
-            // Percorre formas e transforma em anteparos
-            int n;
-            void** array = lista_para_array(formas, &n);
-            if (array != NULL) {
-                for (int i = 0; i < n; i++) {
-                    Forma f = (Forma)array[i];
-                    int id = forma_getId(f);
-                    
-                    if (id >= id_min && id <= id_max) {
-                        // Cria anteparos da forma
-                        Lista anteparos_forma = forma_para_anteparos(f, orient);
-                        if (anteparos_forma != NULL) {
-                            int n_ant;
-                            void** arr_ant = lista_para_array(anteparos_forma, &n_ant);
-                            if (arr_ant != NULL) {
-                                for (int j = 0; j < n_ant; j++) {
-                                    lista_adiciona(anteparos, arr_ant[j]);
-                                }
-                                free(arr_ant);
-                            }
-                            lista_destruir(anteparos_forma);
-                        }
-                        
-                        fprintf(txt_saida, "Forma %d transformada em anteparo\n", id);
-                        lista_adiciona(formas_remover, f);
-                    }
-                }
-                free(array);
-            }
-            
-            // Remove e destroi as formas depois do loop
-            int n_rem;
-            void** arr_rem = lista_para_array(formas_remover, &n_rem);
-            if (arr_rem != NULL) {
-                for (int i = 0; i < n_rem; i++) {
-                    Forma f = (Forma)arr_rem[i];
-                    lista_retira(formas, f);
-                    forma_destroi(f);
-                }
-                free(arr_rem);
-            }
-            lista_destruir(formas_remover);
+        // Lote de bombas seguidas: entre elas os anteparos não mudam
+        const ComandoQry* bombas[MAX_LOTE_BOMBAS];
+        Poligono regioes[MAX_LOTE_BOMBAS];
+        Poligono contornos[MAX_LOTE_BOMBAS];
+        double tempos[MAX_LOTE_BOMBAS];
+        ContagemVisibilidade contagens[MAX_LOTE_BOMBAS];
+        int n_lote = 0;
+        while (i + n_lote < n_comandos && n_lote < MAX_LOTE_BOMBAS &&
+               comando_qry_eh_bomba(programa_qry_comando(programa, i + n_lote))) {
+            bombas[n_lote] = programa_qry_comando(programa, i + n_lote);
+            regioes[n_lote] = NULL;
+            contornos[n_lote] = NULL;
+            tempos[n_lote] = 0;
+            contagens[n_lote].raios = 0;
+            contagens[n_lote].testes = 0;
+            n_lote++;
         }
         
-        // Comando 'd': Bomba de destruição
-        else if (strcmp(comando, "d") == 0) {
-            double x, y;
-            char sufx[64] = "-";
-            sscanf(buffer, "d %lf %lf %s", &x, &y, sufx);
-            
-            fprintf(txt_saida, "[*] d %.2f %.2f\n", x, y);
-            
-            // Desenha anteparos primeiro
-            int n_ant;
-            void** arr_ant = lista_para_array(anteparos, &n_ant);
-            if (arr_ant != NULL) {
-                for (int i = 0; i < n_ant; i++) {
-                    Anteparo a = (Anteparo)arr_ant[i];
-                    anteparo_desenha_svg(a, svg_saida);
-                }
-                free(arr_ant);
-            }
-
-            svg_desenha_asterisco(svg_saida, x, y);
-            
-            // Calcula região de visibilidade
-            Poligono vis = calcula_regiao_visibilidade(x, y, anteparos);
-            
-            if (vis != NULL) {
-                // Desenha região de visibilidade
-                poligono_desenha_svg(vis, svg_saida, "#FF6B6B");
-                
-                // Cria lista temporária de formas a remover
-                Lista formas_remover = lista_cria();
-                
-                // Encontra formas dentro da região
-                int n;
-                void** array = lista_para_array(formas, &n);
-                if (array != NULL) {
-                    for (int i = 0; i < n; i++) {
-                        Forma f = (Forma)array[i];
-                        if (f != NULL && forma_sobrepoe_visibilidade(f, vis)) {
-                            fprintf(txt_saida, "Destruída: forma %d\n", forma_getId(f));
-                            lista_adiciona(formas_remover, f);
-                        }
-                    }
-                    free(array);
-                }
-                
-                // Remove e destroi depois do loop
-                int n_rem;
-                void** arr_rem = lista_para_array(formas_remover, &n_rem);
-                if (arr_rem != NULL) {
-                    for (int i = 0; i < n_rem; i++) {
-                        Forma f = (Forma)arr_rem[i];
-                        lista_retira(formas, f);
-                        forma_destroi(f);
-                    }
-                    free(arr_rem);
-                }
-                lista_destruir(formas_remover);
-                
-                poligono_destroi(vis);
-            }
-        }
+        // O desenho do grupo de anteparos conta como saída da primeira bomba do lote
+        double inicio_preparo = est != NULL ? estatisticas_relogio() : 0;
+        prepara_anteparos(&estado, cmd->versao_anteparos);
+        double tempo_preparo = est != NULL ? estatisticas_relogio() - inicio_preparo : 0;
+        calcula_lote(&estado, bombas, regioes, contornos, est != NULL ? tempos : NULL,
+                     est != NULL ? contagens : NULL, n_lote);
         
-        // Comando 'p': Bomba de pintura
-        else if (strcmp(comando, "p") == 0) {
-            double x, y;
-            char cor[32];
-            char sufx[64] = "-";
-            sscanf(buffer, "p %lf %lf %s %s", &x, &y, cor, sufx);
-            
-            fprintf(txt_saida, "[*] p %.2f %.2f %s\n", x, y, cor);
-            
-            // Desenha anteparos
-            int n_ant;
-            void** arr_ant = lista_para_array(anteparos, &n_ant);
-            if (arr_ant != NULL) {
-                for (int i = 0; i < n_ant; i++) {
-                    Anteparo a = (Anteparo)arr_ant[i];
-                    anteparo_desenha_svg(a, svg_saida);
-                }
-                free(arr_ant);
+        for (int k = 0; k < n_lote; k++) {
+            long long alocacoes = alocacoes_ate_agora(est);
+            estatisticas_abre_registro(est, nome_comando(bombas[k]->tipo), i + k);
+            estatisticas_soma_tempo(est, FASE_SAIDA, k == 0 ? tempo_preparo : 0);
+            estatisticas_soma_tempo(est, FASE_VISIBILIDADE, tempos[k]);
+            estatisticas_soma(est, CONT_RAIOS, contagens[k].raios);
+            estatisticas_soma(est, CONT_TESTES_SEGMENTO, contagens[k].testes);
+            if (contornos[k] != NULL) {
+                estatisticas_soma(est, CONT_VERTICES, poligono_num_vertices(contornos[k]));
             }
             
-
-            Poligono vis = calcula_regiao_visibilidade(x, y, anteparos);
-            
-            if (vis != NULL) {
-                poligono_desenha_svg(vis, svg_saida, "#4ECDC4");
-                
-                // Pinta formas dentro da região
-                int n;
-                void** array = lista_para_array(formas, &n);
-                if (array != NULL) {
-                    for (int i = 0; i < n; i++) {
-                        Forma f = (Forma)array[i];
-                        if (f != NULL && forma_sobrepoe_visibilidade(f, vis)) {
-                            fprintf(txt_saida, "Pintada: forma %d\n", forma_getId(f));
-                            forma_setCorPreenchimento(f, (char*)cor);
-                            forma_setCorBorda(f, (char*)cor);
-                        }
-                    }
-                    free(array);
-                }
-                
-                poligono_destroi(vis);
+            switch (bombas[k]->tipo) {
+                case QRY_DESTRUICAO:
+                    executa_destruicao(&estado, bombas[k], regioes[k], contornos[k]);
+                    break;
+                case QRY_PINTURA:
+                    executa_pintura(&estado, bombas[k], regioes[k], contornos[k]);
+                    break;
+                case QRY_CLONAGEM:
+                    executa_clonagem(&estado, bombas[k], regioes[k], contornos[k]);
+                    break;
+                default:
+                    break;
             }
+            fecha_registro_comando(&estado, alocacoes);
         }
         
-        // Comando 'cln': Bomba de clonagem
-        else if (strcmp(comando, "cln") == 0) {
-            double x, y, dx, dy;
-            char sufx[64] = "-";
-            sscanf(buffer, "cln %lf %lf %lf %lf %s", &x, &y, &dx, &dy, sufx);
-            
-            fprintf(txt_saida, "[*] cln %.2f %.2f %.2f %.2f\n", x, y, dx, dy);
-            
-            // Desenha anteparos
-            int n_ant;
-            void** arr_ant = lista_para_array(anteparos, &n_ant);
-            if (arr_ant != NULL) {
-                for (int i = 0; i < n_ant; i++) {
-                    Anteparo a = (Anteparo)arr_ant[i];
-                    anteparo_desenha_svg(a, svg_saida);
-                }
-                free(arr_ant);
-            }
-            
-            // Calcula região de visibilidade
-            Poligono vis = calcula_regiao_visibilidade(x, y, anteparos);
-            
-            if (vis != NULL) {
-                poligono_desenha_svg(vis, svg_saida, "#95E1D3");
-                
-                // Clona formas dentro da região
-                int n;
-                void** array = lista_para_array(formas, &n);
-                if (array != NULL) {
-                    for (int i = 0; i < n; i++) {
-                        Forma f = (Forma)array[i];
-                        if (f != NULL && forma_sobrepoe_visibilidade(f, vis)) {
-                            Forma clone = forma_clonar(f, dx, dy);
-                            if (clone != NULL) {
-                                fprintf(txt_saida, "Clonada: forma %d como %d\n", 
-                                        forma_getId(f), forma_getId(clone));
-                                lista_adiciona(formas, clone);
-                            }
-                        }
-                    }
-                    free(array);
-                }
-                
-                poligono_destroi(vis);
+        // Regiões compartilhadas por origens repetidas são destruídas uma vez só
+        for (int k = 0; k < n_lote; k++) {
+            if (regioes[k] != NULL && (k + 1 == n_lote || regioes[k + 1] != regioes[k])) {
+                poligono_destroi(regioes[k]);
+                poligono_destroi(contornos[k]);
             }
         }
+        
+        i += n_lote;
     }
     
-    // Limpa anteparos
-    int n;
-    void** array = lista_para_array(anteparos, &n);
-    if (array != NULL) {
-        for (int i = 0; i < n; i++) {
-            anteparo_destroi((Anteparo)array[i]);
-        }
-        free(array);
-    }
-    lista_destruir(anteparos);
+    tabela_formas_destroi(estado.tabela);
+    
+    conjunto_anteparos_destroi(estado.anteparos);
     
     // Desenha formas finais
-    array = lista_para_array(formas, &n);
+    estatisticas_abre_registro(est, "final", -1);
+    int n;
+    void** array = lista_para_array(formas, &n);
     if (array != NULL) {
         for (int i = 0; i < n; i++) {
             Forma f = (Forma)array[i];
@@ -273,6 +487,8 @@ void processaQry(const char *path_qry, Lista formas, const char *path_svg_saida,
     }
     
     svg_finaliza(svg_saida);
-    fclose(txt_saida);
-    fclose(arquivo_qry);
-}
\ No newline at end of file
+    saida_fecha(txt_saida);
+    estatisticas_marca(est, FASE_SAIDA);
+    estatisticas_fecha_registro(est, lista_tamanho(formas));
+    programa_qry_destroi(programa);
+}
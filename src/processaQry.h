@@ -2,6 +2,7 @@
 #define PROCESSAQRY_H
 
 #include "lista.h"
+#include "estatisticas.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -17,7 +18,11 @@
  * @param formas A lista de formas vinda do geo.
  * @param path_svg_saida O caminho onde deve ser gerado o txt.
  * @param path_txt_saida O caminho onde deve ser gerado o svg_final.
+ * @param svg_comprimido 1 para gravar o svg comprimido com gzip (.svgz).
+ * @param txt_comprimido 1 para gravar o txt comprimido com gzip (.txt.gz).
+ * @param est Onde registrar as estatísticas de cada comando (NULL para não medir).
  */
-void processaQry(const char *path_qry, Lista formas, const char *path_svg_saida, const char *path_txt_saida);
+void processaQry(const char *path_qry, Lista formas, const char *path_svg_saida, const char *path_txt_saida,
+                 int svg_comprimido, int txt_comprimido, Estatisticas est);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,166 @@
+#include "programaQry.h"
+#include "leitor.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    ComandoQry* comandos;
+    int n, capacidade;
+} EstruturaPrograma;
+
+// Avisa que a linha foi ignorada; retorna 0 para o chamador repassar
+static int descarta_linha(const char* comando, int num_linha, const char* motivo) {
+    printf("Erro: linha %d do qry ignorada ('%s'): %s\n", num_linha, comando, motivo);
+    return 0;
+}
+
+// Interpreta uma linha; retorna 1 se ela gerou um comando (linhas vazias e comentários não geram)
+static int compila_linha(CursorTexto* linha, ComandoQry* cmd, int num_linha) {
+    char comando[16];
+
+    if (linha->p == linha->fim || linha->p[0] == '#') {
+        return 0;
+    }
+    if (!cursor_le_palavra(linha, comando, sizeof(comando))) {
+        return 0;
+    }
+
+    memset(cmd, 0, sizeof(ComandoQry));
+    strcpy(cmd->sufixo, "-");
+
+    if (strcmp(comando, "a") == 0) {
+        char orientacao[8] = "h";
+        cmd->tipo = QRY_ANTEPARO;
+        if (!cursor_le_decimal(linha, &cmd->id_min) || !cursor_le_decimal(linha, &cmd->id_max)) {
+            return descarta_linha(comando, num_linha, "faltam os ids");
+        }
+        cursor_le_palavra(linha, orientacao, sizeof(orientacao));
+        cmd->orientacao = orientacao[0];
+        return 1;
+    }
+
+    if (strcmp(comando, "d") == 0) {
+        cmd->tipo = QRY_DESTRUICAO;
+    } else if (strcmp(comando, "p") == 0) {
+        cmd->tipo = QRY_PINTURA;
+    } else if (strcmp(comando, "cln") == 0) {
+        cmd->tipo = QRY_CLONAGEM;
+    } else {
+        return descarta_linha(comando, num_linha, "comando desconhecido");
+    }
+
+    if (!cursor_le_double(linha, &cmd->x) || !cursor_le_double(linha, &cmd->y)) {
+        return descarta_linha(comando, num_linha, "faltam as coordenadas");
+    }
+    if (cmd->tipo == QRY_PINTURA) {
+        if (!cursor_le_palavra(linha, cmd->cor, sizeof(cmd->cor))) {
+            return descarta_linha(comando, num_linha, "falta a cor");
+        }
+        cmd->id_cor = cores_interna(cmd->cor);
+    }
+    if (cmd->tipo == QRY_CLONAGEM &&
+        (!cursor_le_double(linha, &cmd->dx) || !cursor_le_double(linha, &cmd->dy))) {
+        return descarta_linha(comando, num_linha, "faltam dx e dy");
+    }
+    cursor_le_palavra(linha, cmd->sufixo, sizeof(cmd->sufixo));
+    return 1;
+}
+
+static int adiciona_comando(EstruturaPrograma* prog, const ComandoQry* cmd) {
+    if (prog->n == prog->capacidade) {
+        int nova_cap = prog->capacidade == 0 ? 64 : prog->capacidade * 2;
+        ComandoQry* novo = (ComandoQry*) realloc(prog->comandos, (size_t)nova_cap * sizeof(ComandoQry));
+        if (novo == NULL) {
+            printf("Erro ao alocar comandos do qry\n");
+            return 0;
+        }
+        prog->comandos = novo;
+        prog->capacidade = nova_cap;
+    }
+    prog->comandos[prog->n++] = *cmd;
+    return 1;
+}
+
+// Segunda passada: versões do conjunto de anteparos e origens repetidas
+static void analisa_programa(EstruturaPrograma* prog) {
+    int versao = 0;
+    const ComandoQry* bomba_anterior = NULL;
+
+    for (int i = 0; i < prog->n; i++) {
+        ComandoQry* cmd = &prog->comandos[i];
+        if (cmd->tipo == QRY_ANTEPARO) {
+            versao++;
+            bomba_anterior = NULL;
+            cmd->versao_anteparos = versao;
+            continue;
+        }
+
+        cmd->versao_anteparos = versao;
+        cmd->repete_origem = bomba_anterior != NULL &&
+                             bomba_anterior->x == cmd->x && bomba_anterior->y == cmd->y;
+        bomba_anterior = cmd;
+    }
+}
+
+ProgramaQry programa_qry_compila(const char* caminho) {
+    ArquivoMapeado arquivo = arquivo_mapeia(caminho);
+    if (arquivo == NULL) {
+        return NULL;
+    }
+
+    EstruturaPrograma* prog = (EstruturaPrograma*) malloc(sizeof(EstruturaPrograma));
+    if (prog == NULL) {
+        printf("Erro ao alocar programa do qry\n");
+        arquivo_libera(arquivo);
+        return NULL;
+    }
+    prog->comandos = NULL;
+    prog->n = 0;
+    prog->capacidade = 0;
+
+    CursorTexto cursor, linha;
+    cursor_inicia(&cursor, arquivo_dados(arquivo), arquivo_tamanho(arquivo));
+
+    int num_linha = 0;
+    while (cursor_proxima_linha(&cursor, &linha)) {
+        ComandoQry cmd;
+        num_linha++;
+        if (compila_linha(&linha, &cmd, num_linha) && !adiciona_comando(prog, &cmd)) {
+            programa_qry_destroi(prog);
+            arquivo_libera(arquivo);
+            return NULL;
+        }
+    }
+
+    analisa_programa(prog);
+
+    arquivo_libera(arquivo);
+    return (ProgramaQry) prog;
+}
+
+int programa_qry_tamanho(ProgramaQry programa) {
+    EstruturaPrograma* prog = (EstruturaPrograma*) programa;
+    return prog != NULL ? prog->n : 0;
+}
+
+const ComandoQry* programa_qry_comando(ProgramaQry programa, int i) {
+    EstruturaPrograma* prog = (EstruturaPrograma*) programa;
+    if (prog == NULL || i < 0 || i >= prog->n) {
+        return NULL;
+    }
+    return &prog->comandos[i];
+}
+
+int comando_qry_eh_bomba(const ComandoQry* comando) {
+    return comando != NULL && comando->tipo != QRY_ANTEPARO;
+}
+
+void programa_qry_destroi(ProgramaQry programa) {
+    EstruturaPrograma* prog = (EstruturaPrograma*) programa;
+    if (prog == NULL) {
+        return;
+    }
+    free(prog->comandos);
+    free(prog);
+}
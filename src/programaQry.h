@@ -0,0 +1,67 @@
+#ifndef PROGRAMAQRY_H
+#define PROGRAMAQRY_H
+
+/*
+* Programa de Consultas (.qry) pré-compilado.
+* O arquivo .qry inteiro é lido antes da execução e convertido em um array de
+* comandos tipados. Com o programa completo à vista, o interpretador (processaQry)
+* pode olhar adiante: agrupar bombas seguidas que usam os mesmos anteparos, reaproveitar
+* a região de visibilidade de origens repetidas e preparar os anteparos antes de usá-los.
+*/
+
+#include "cores.h"
+
+typedef void* ProgramaQry;
+
+typedef enum {
+    QRY_ANTEPARO,            // a i j [v|h]
+    QRY_DESTRUICAO,          // d x y sfx
+    QRY_PINTURA,             // p x y cor sfx
+    QRY_CLONAGEM             // cln x y dx dy sfx
+} TipoComandoQry;
+
+/*
+* Um comando já interpretado. Os campos que não se aplicam ao tipo ficam zerados.
+*/
+typedef struct {
+    TipoComandoQry tipo;
+    int id_min, id_max;      // a
+    char orientacao;         // a
+    double x, y;             // Origem das bombas
+    double dx, dy;           // cln
+    char cor[32];            // p
+    IdCor id_cor;            // p: a mesma cor, já internada
+    char sufixo[64];
+    int versao_anteparos;    // Quantos comandos 'a' vieram antes deste
+    int repete_origem;       // Bomba com a mesma origem e anteparos da bomba anterior
+} ComandoQry;
+
+/**
+ * @brief Lê e compila um arquivo .qry.
+ * Linhas vazias, comentários, comandos desconhecidos e comandos com campos faltando são ignorados.
+ * @param caminho Caminho do arquivo .qry.
+ * @return ProgramaQry O programa compilado, ou NULL em caso de erro.
+ */
+ProgramaQry programa_qry_compila(const char* caminho);
+
+/**
+ * @brief Retorna o número de comandos do programa.
+ */
+int programa_qry_tamanho(ProgramaQry programa);
+
+/**
+ * @brief Retorna o i-ésimo comando (começando em 0), ou NULL se fora do intervalo.
+ */
+const ComandoQry* programa_qry_comando(ProgramaQry programa, int i);
+
+/**
+ * @brief Verifica se o comando é uma bomba (d, p ou cln), que calcula região de visibilidade.
+ */
+int comando_qry_eh_bomba(const ComandoQry* comando);
+
+/**
+ * @brief Libera o programa e seus comandos.
+ */
+void programa_qry_destroi(ProgramaQry programa);
+
+#endif
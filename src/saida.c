@@ -0,0 +1,276 @@
+#include "saida.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <pthread.h>
+
+#ifdef TEM_ZLIB
+#include <zlib.h>
+#endif
+
+// Buffer interno da zlib para cada saída comprimida.
+#define TAM_BUFFER_GZIP (256 * 1024)
+// Tamanho de cada bloco do anel.
+#define TAM_BLOCO_SAIDA (256 * 1024)
+// Blocos no anel: um sendo preenchido, um sendo gravado e folga entre os dois.
+#define NUM_BLOCOS_SAIDA 4
+
+typedef struct {
+    char* dados;
+    size_t usado;
+} BlocoSaida;
+
+/*
+* Anel produtor/consumidor único: o programa preenche anel[cauda] e o publica;
+* a thread escritora grava anel[cabeca] e o devolve. 'prontos' conta os blocos
+* publicados e ainda não gravados (incluindo o que está sendo gravado).
+*/
+typedef struct {
+    FILE* arquivo;           // Saída comum
+#ifdef TEM_ZLIB
+    gzFile gz;               // Saída comprimida (NULL se comum)
+#endif
+    BlocoSaida anel[NUM_BLOCOS_SAIDA];
+    size_t cabeca;
+    size_t cauda;
+    size_t prontos;
+    int fim;                 // Produtor terminou: a escritora sai quando esvaziar o anel
+    int erro;                // Alguma gravação falhou
+
+    int assincrona;          // 0 se a thread não pôde ser criada (grava na hora)
+    pthread_t escritora;
+    pthread_mutex_t trava;
+    pthread_cond_t tem_bloco;
+    pthread_cond_t tem_espaco;
+} EstruturaSaida;
+
+int saida_compressao_disponivel(void) {
+#ifdef TEM_ZLIB
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+/*
+* Grava um bloco no destino final (arquivo ou fluxo gzip).
+*/
+static int grava_destino(EstruturaSaida* saida, const char* p, size_t n) {
+#ifdef TEM_ZLIB
+    if (saida->gz != NULL) {
+        // gzwrite recebe unsigned: trechos enormes vão em partes
+        while (n > 0) {
+            unsigned parte = n > (1u << 30) ? (1u << 30) : (unsigned) n;
+            if (gzwrite(saida->gz, p, parte) != (int) parte) {
+                return 0;
+            }
+            p += parte;
+            n -= parte;
+        }
+        return 1;
+    }
+#endif
+    return fwrite(p, 1, n, saida->arquivo) == n;
+}
+
+static void* laco_escritora(void* arg) {
+    EstruturaSaida* saida = (EstruturaSaida*) arg;
+
+    pthread_mutex_lock(&saida->trava);
+    for (;;) {
+        while (saida->prontos == 0 && !saida->fim) {
+            pthread_cond_wait(&saida->tem_bloco, &saida->trava);
+        }
+        if (saida->prontos == 0) break;
+
+        BlocoSaida* bloco = &saida->anel[saida->cabeca];
+        pthread_mutex_unlock(&saida->trava);
+
+        // Grava sem segurar a trava: o produtor continua preenchendo o próximo bloco
+        int ok = grava_destino(saida, bloco->dados, bloco->usado);
+
+        pthread_mutex_lock(&saida->trava);
+        if (!ok) saida->erro = 1;
+        saida->cabeca = (saida->cabeca + 1) % NUM_BLOCOS_SAIDA;
+        saida->prontos--;
+        pthread_cond_signal(&saida->tem_espaco);
+    }
+    pthread_mutex_unlock(&saida->trava);
+    return NULL;
+}
+
+/*
+* Entrega o bloco atual à escritora e passa a preencher o próximo livre,
+* esperando se o anel estiver cheio.
+*/
+static void publica_bloco(EstruturaSaida* saida) {
+    BlocoSaida* atual = &saida->anel[saida->cauda];
+    if (atual->usado == 0) return;
+
+    if (!saida->assincrona) {
+        if (!grava_destino(saida, atual->dados, atual->usado)) saida->erro = 1;
+        atual->usado = 0;
+        return;
+    }
+
+    pthread_mutex_lock(&saida->trava);
+    saida->prontos++;
+    pthread_cond_signal(&saida->tem_bloco);
+    while (saida->prontos >= NUM_BLOCOS_SAIDA) {
+        pthread_cond_wait(&saida->tem_espaco, &saida->trava);
+    }
+    saida->cauda = (saida->cauda + 1) % NUM_BLOCOS_SAIDA;
+    saida->anel[saida->cauda].usado = 0;
+    pthread_mutex_unlock(&saida->trava);
+}
+
+static void libera_estrutura(EstruturaSaida* saida) {
+    for (int i = 0; i < NUM_BLOCOS_SAIDA; i++) {
+        free(saida->anel[i].dados);
+    }
+    free(saida);
+}
+
+Saida saida_abre(const char* caminho, int comprimida) {
+    EstruturaSaida* saida = (EstruturaSaida*) calloc(1, sizeof(EstruturaSaida));
+    if (saida == NULL) {
+        printf("Erro ao alocar saida\n");
+        return NULL;
+    }
+    for (int i = 0; i < NUM_BLOCOS_SAIDA; i++) {
+        saida->anel[i].dados = (char*) malloc(TAM_BLOCO_SAIDA);
+        if (saida->anel[i].dados == NULL) {
+            printf("Erro ao alocar saida\n");
+            libera_estrutura(saida);
+            return NULL;
+        }
+    }
+
+#ifdef TEM_ZLIB
+    saida->gz = NULL;
+    if (comprimida) {
+        saida->gz = gzopen(caminho, "wb6");
+        if (saida->gz == NULL) {
+            printf("Erro ao criar o arquivo %s\n", caminho);
+            libera_estrutura(saida);
+            return NULL;
+        }
+        gzbuffer(saida->gz, TAM_BUFFER_GZIP);
+    }
+#else
+    if (comprimida) {
+        printf("Erro: compressao indisponivel (compilado sem zlib)\n");
+        libera_estrutura(saida);
+        return NULL;
+    }
+#endif
+
+    if (!comprimida) {
+        saida->arquivo = fopen(caminho, "w");
+        if (saida->arquivo == NULL) {
+            libera_estrutura(saida);
+            return NULL;
+        }
+        // Os blocos já chegam grandes: o buffer do stdio só acrescentaria uma cópia
+        setvbuf(saida->arquivo, NULL, _IONBF, 0);
+    }
+
+    pthread_mutex_init(&saida->trava, NULL);
+    pthread_cond_init(&saida->tem_bloco, NULL);
+    pthread_cond_init(&saida->tem_espaco, NULL);
+    saida->assincrona = pthread_create(&saida->escritora, NULL, laco_escritora, saida) == 0;
+
+    return (Saida) saida;
+}
+
+int saida_escreve(Saida s, const void* dados, size_t n) {
+    EstruturaSaida* saida = (EstruturaSaida*) s;
+    if (saida == NULL) return 0;
+
+    const char* p = (const char*) dados;
+    while (n > 0) {
+        BlocoSaida* atual = &saida->anel[saida->cauda];
+        size_t livre = TAM_BLOCO_SAIDA - atual->usado;
+        if (livre == 0) {
+            publica_bloco(saida);
+            continue;
+        }
+        size_t parte = n < livre ? n : livre;
+        memcpy(atual->dados + atual->usado, p, parte);
+        atual->usado += parte;
+        p += parte;
+        n -= parte;
+    }
+    return 1;
+}
+
+int saida_printf(Saida s, const char* formato, ...) {
+    EstruturaSaida* saida = (EstruturaSaida*) s;
+    if (saida == NULL) return -1;
+
+    va_list args;
+    BlocoSaida* atual = &saida->anel[saida->cauda];
+    size_t livre = TAM_BLOCO_SAIDA - atual->usado;
+
+    // Formata direto no bloco atual
+    va_start(args, formato);
+    int n = vsnprintf(atual->dados + atual->usado, livre, formato, args);
+    va_end(args);
+    if (n < 0) return n;
+
+    if ((size_t) n < livre) {
+        atual->usado += (size_t) n;
+        return n;
+    }
+
+    // Não coube: formata de novo em um bloco novo ou, se nem assim couber, à parte
+    if ((size_t) n < TAM_BLOCO_SAIDA) {
+        publica_bloco(saida);
+        atual = &saida->anel[saida->cauda];
+        va_start(args, formato);
+        vsnprintf(atual->dados, TAM_BLOCO_SAIDA, formato, args);
+        va_end(args);
+        atual->usado = (size_t) n;
+        return n;
+    }
+
+    char* texto = (char*) malloc((size_t) n + 1);
+    if (texto == NULL) return -1;
+    va_start(args, formato);
+    vsnprintf(texto, (size_t) n + 1, formato, args);
+    va_end(args);
+    int ok = saida_escreve(saida, texto, (size_t) n);
+    free(texto);
+    return ok ? n : -1;
+}
+
+int saida_fecha(Saida s) {
+    EstruturaSaida* saida = (EstruturaSaida*) s;
+    if (saida == NULL) return 0;
+
+    publica_bloco(saida);
+    if (saida->assincrona) {
+        pthread_mutex_lock(&saida->trava);
+        saida->fim = 1;
+        pthread_cond_signal(&saida->tem_bloco);
+        pthread_mutex_unlock(&saida->trava);
+        pthread_join(saida->escritora, NULL);
+    }
+    pthread_mutex_destroy(&saida->trava);
+    pthread_cond_destroy(&saida->tem_bloco);
+    pthread_cond_destroy(&saida->tem_espaco);
+
+    int ok = !saida->erro;
+#ifdef TEM_ZLIB
+    if (saida->gz != NULL) {
+        ok = gzclose(saida->gz) == Z_OK && ok;
+        libera_estrutura(saida);
+        return ok;
+    }
+#endif
+
+    ok = fclose(saida->arquivo) == 0 && ok;
+    libera_estrutura(saida);
+    return ok;
+}
@@ -0,0 +1,55 @@
+#ifndef SAIDA_H
+#define SAIDA_H
+
+#include <stddef.h>
+
+/*
+* Módulo de Arquivos de Saída.
+* Abstrai o destino dos relatórios: um arquivo comum ou um fluxo gzip (.svgz, .txt.gz)
+* comprimido incrementalmente à medida que os dados chegam, sem guardar o arquivo
+* inteiro em memória. A compressão depende da zlib; o Makefile define TEM_ZLIB quando
+* ela está instalada.
+*
+* A gravação em disco (e a compressão) roda em uma thread própria por saída: quem escreve
+* só copia os bytes para blocos de um anel limitado, e a thread escritora os grava na
+* mesma ordem. Se o anel enche, quem escreve espera. Cada Saida deve ser usada por
+* uma única thread.
+*/
+
+typedef void* Saida;
+
+/**
+ * @brief Indica se o programa foi compilado com suporte a compressão.
+ * @return int 1 se a zlib está disponível, 0 caso contrário.
+ */
+int saida_compressao_disponivel(void);
+
+/**
+ * @brief Abre (criando ou truncando) um arquivo de saída.
+ * @param caminho Caminho do arquivo.
+ * @param comprimida 1 para gravar um fluxo gzip, 0 para arquivo comum.
+ * @return Saida A saída aberta, ou NULL em caso de erro.
+ */
+Saida saida_abre(const char* caminho, int comprimida);
+
+/**
+ * @brief Escreve 'n' bytes na saída.
+ * @return int 1 em caso de sucesso, 0 em caso de erro. Falhas da gravação em
+ * segundo plano só são informadas por saida_fecha.
+ */
+int saida_escreve(Saida saida, const void* dados, size_t n);
+
+/**
+ * @brief Escreve texto formatado, como o fprintf.
+ * @return int Número de bytes escritos, ou negativo em caso de erro.
+ */
+int saida_printf(Saida saida, const char* formato, ...);
+
+/**
+ * @brief Entrega o bloco pendente, espera a thread escritora gravar tudo, finaliza
+ * o fluxo e fecha o arquivo.
+ * @return int 1 em caso de sucesso, 0 se alguma gravação falhou.
+ */
+int saida_fecha(Saida saida);
+
+#endif
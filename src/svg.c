@@ -1,54 +1,188 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
 
 #include "svg.h"
+#include "saida.h"
 
 
-const char* SVG_HEADER_VIEWBOX = "<svg xmlns=\"http://www.w3.org/2000/svg\" viewBox=\"0 0 1000 700\" width=\"1000\" height=\"700\">\n";
+const char* SVG_HEADER_VIEWBOX = "<svg xmlns=\"http://www.w3.org/2000/svg\" xmlns:xlink=\"http://www.w3.org/1999/xlink\" viewBox=\"0 0 1000 700\" width=\"1000\" height=\"700\">\n";
 const char* SVG_BACKGROUND = "\t<rect width=\"100%\" height=\"100%\" fill=\"#f4f4f4\" />\n";
 const char* SVG_FOOTER = "</svg>\n";
 
+// Acima disso (em módulo) os números são formatados pelo snprintf.
+#define MAX_NUMERO_RAPIDO 1e9
+// Maior saída de svg_escreve_numero no caminho lento (%.3f de um double qualquer).
+#define TAM_NUMERO_LENTO 352
 
-FILE* svg_inicia(const char* path_svg) {
-    FILE* f = fopen(path_svg, "w");
+typedef struct {
+    Saida saida;             // Arquivo comum ou fluxo gzip, gravado em segundo plano
+} EstruturaEscritor;
+
+static const double escalas[] = {1, 10, 100, 1000};
+
+
+EscritorSvg svg_inicia(const char* path_svg, int comprimido) {
+    Saida f = saida_abre(path_svg, comprimido);
     if (f == NULL) {
         printf("Erro(0) em svg_inicia: Nao foi possivel criar o arquivo %s\n", path_svg);
         return NULL;
     }
 
-    fprintf(f, "%s", SVG_HEADER_VIEWBOX);
-    fprintf(f, "%s", SVG_BACKGROUND);
+    EstruturaEscritor* svg = (EstruturaEscritor*) malloc(sizeof(EstruturaEscritor));
+    if (svg == NULL) {
+        printf("Erro(1) em svg_inicia: Nao foi possivel alocar o escritor\n");
+        saida_fecha(f);
+        return NULL;
+    }
+
+    svg->saida = f;
+
+    svg_escreve_texto(svg, SVG_HEADER_VIEWBOX);
+    svg_escreve_texto(svg, SVG_BACKGROUND);
     
-    return f;
+    return (EscritorSvg) svg;
+}
+
+void svg_finaliza(EscritorSvg s) {
+    EstruturaEscritor* svg = (EstruturaEscritor*) s;
+    if (svg == NULL) return;
+    svg_escreve_texto(svg, SVG_FOOTER);
+    // Espera a thread escritora gravar o restante e fecha o arquivo
+    saida_fecha(svg->saida);
+    free(svg);
 }
 
-void svg_finaliza(FILE* svg_file) {
-    if (svg_file == NULL) return;
-    fprintf(svg_file, "%s", SVG_FOOTER);
-    fclose(svg_file);
+/*=========================*/
+/* Escrita de Baixo Nível  */
+/*=========================*/
+
+void svg_escreve_bytes(EscritorSvg s, const char* dados, size_t n) {
+    EstruturaEscritor* svg = (EstruturaEscritor*) s;
+    if (svg == NULL) return;
+    saida_escreve(svg->saida, dados, n);
+}
+
+void svg_escreve_texto(EscritorSvg svg, const char* s) {
+    if (s == NULL) {
+        svg_escreve_literal(svg, "(null)");
+        return;
+    }
+    svg_escreve_bytes(svg, s, strlen(s));
+}
+
+/*
+* Arredonda |valor| * 10^casas para o inteiro mais próximo exatamente como o printf,
+* que arredonda o valor binário exato (empates para o par). O produto em double só
+* pode errar o lado do arredondamento quando cai muito perto de k + 0.5; nesse caso
+* o fma decide pelo sinal exato de valor * escala - (k + 0.5).
+*/
+static unsigned long long arredonda_escala(double valor, double escala) {
+    double t = valor * escala;
+    double k = floor(t);
+    double fracao = t - k;
+    
+    if (fabs(fracao - 0.5) > 1e-3) {
+        return (unsigned long long) k + (fracao > 0.5);
+    }
+    
+    double diferenca = fma(valor, escala, -(k + 0.5));
+    unsigned long long n = (unsigned long long) k;
+    if (diferenca > 0 || (diferenca == 0 && (n & 1))) {
+        n++;
+    }
+    return n;
+}
+
+void svg_escreve_numero(EscritorSvg svg, double valor, int casas) {
+    char texto[TAM_NUMERO_LENTO];
+    
+    if (casas < 0 || casas > 3 || !(fabs(valor) < MAX_NUMERO_RAPIDO)) {
+        // NaN, infinito, números enormes ou casas fora do previsto: printf
+        int n = snprintf(texto, sizeof(texto), "%.*f", casas, valor);
+        if (n > 0) {
+            svg_escreve_bytes(svg, texto, (size_t)n < sizeof(texto) ? (size_t)n : sizeof(texto) - 1);
+        }
+        return;
+    }
+    
+    unsigned long long n = arredonda_escala(fabs(valor), escalas[casas]);
+    
+    // Monta de trás para frente: casas decimais, ponto e parte inteira
+    char* fim = texto + sizeof(texto);
+    char* p = fim;
+    for (int i = 0; i < casas; i++) {
+        *--p = (char)('0' + n % 10);
+        n /= 10;
+    }
+    if (casas > 0) {
+        *--p = '.';
+    }
+    do {
+        *--p = (char)('0' + n % 10);
+        n /= 10;
+    } while (n > 0);
+    // O printf mantém o sinal de -0.0 e de negativos que arredondam para zero
+    if (signbit(valor)) {
+        *--p = '-';
+    }
+    
+    svg_escreve_bytes(svg, p, (size_t)(fim - p));
 }
 
 /*===============================*/
 /* Funções Primitivas de Desenho */
 /*===============================*/
 
-void svg_desenha_circulo(FILE* f, double x, double y, double r, char* corb, char* corp) {
+void svg_desenha_circulo(EscritorSvg f, double x, double y, double r, char* corb, char* corp) {
     if (f == NULL) return;
-    fprintf(f, "\t<circle cx=\"%.2f\" cy=\"%.2f\" r=\"%.2f\" stroke=\"%s\" fill=\"%s\" fill-opacity=\"0.5\" stroke-width=\"1.5\" />\n", x, y, r, corb, corp);
+    svg_escreve_literal(f, "\t<circle cx=\"");
+    svg_escreve_numero(f, x, 2);
+    svg_escreve_literal(f, "\" cy=\"");
+    svg_escreve_numero(f, y, 2);
+    svg_escreve_literal(f, "\" r=\"");
+    svg_escreve_numero(f, r, 2);
+    svg_escreve_literal(f, "\" stroke=\"");
+    svg_escreve_texto(f, corb);
+    svg_escreve_literal(f, "\" fill=\"");
+    svg_escreve_texto(f, corp);
+    svg_escreve_literal(f, "\" fill-opacity=\"0.5\" stroke-width=\"1.5\" />\n");
 }
 
-void svg_desenha_retangulo(FILE* f, double x, double y, double w, double h, char* corb, char* corp) {
+void svg_desenha_retangulo(EscritorSvg f, double x, double y, double w, double h, char* corb, char* corp) {
     if (f == NULL) return;
-    fprintf(f, "\t<rect x=\"%.2f\" y=\"%.2f\" width=\"%.2f\" height=\"%.2f\" stroke=\"%s\" fill=\"%s\" fill-opacity=\"0.5\" stroke-width=\"1.5\" />\n", x, y, w, h, corb, corp);
+    svg_escreve_literal(f, "\t<rect x=\"");
+    svg_escreve_numero(f, x, 2);
+    svg_escreve_literal(f, "\" y=\"");
+    svg_escreve_numero(f, y, 2);
+    svg_escreve_literal(f, "\" width=\"");
+    svg_escreve_numero(f, w, 2);
+    svg_escreve_literal(f, "\" height=\"");
+    svg_escreve_numero(f, h, 2);
+    svg_escreve_literal(f, "\" stroke=\"");
+    svg_escreve_texto(f, corb);
+    svg_escreve_literal(f, "\" fill=\"");
+    svg_escreve_texto(f, corp);
+    svg_escreve_literal(f, "\" fill-opacity=\"0.5\" stroke-width=\"1.5\" />\n");
 }
 
-void svg_desenha_linha(FILE* f, double x1, double y1, double x2, double y2, char* cor) {
+void svg_desenha_linha(EscritorSvg f, double x1, double y1, double x2, double y2, char* cor) {
     if (f == NULL) return;
-    fprintf(f, "\t<line x1=\"%.2f\" y1=\"%.2f\" x2=\"%.2f\" y2=\"%.2f\" stroke=\"%s\" stroke-width=\"2\" />\n",x1, y1, x2, y2, cor);
+    svg_escreve_literal(f, "\t<line x1=\"");
+    svg_escreve_numero(f, x1, 2);
+    svg_escreve_literal(f, "\" y1=\"");
+    svg_escreve_numero(f, y1, 2);
+    svg_escreve_literal(f, "\" x2=\"");
+    svg_escreve_numero(f, x2, 2);
+    svg_escreve_literal(f, "\" y2=\"");
+    svg_escreve_numero(f, y2, 2);
+    svg_escreve_literal(f, "\" stroke=\"");
+    svg_escreve_texto(f, cor);
+    svg_escreve_literal(f, "\" stroke-width=\"2\" />\n");
 }
 
-void svg_desenha_texto(FILE* f, double x, double y, char* corb, char* corp, char* txto, char* fFamily, char* fWeight, double fSize, char anr) {
+void svg_desenha_texto(EscritorSvg f, double x, double y, char* corb, char* corp, char* txto, char* fFamily, char* fWeight, double fSize, char anr) {
     if (f == NULL) return;
 
     const char* anr_str = "start"; 
@@ -88,19 +222,79 @@ void svg_desenha_texto(FILE* f, double x, double y, char* corb, char* corp, char
         }
     }
 
-    fprintf(f, "\t<text x=\"%.2f\" y=\"%.2f\" fill=\"%s\" stroke=\"%s\" font-family=\"%s\" font-weight=\"%s\" font-size=\"%.1fpx\" text-anchor=\"%s\">%s</text>\n", 
-            x, y, corp, corb, family_svg, weight_svg, fSize, anr_str, txto);
+    svg_escreve_literal(f, "\t<text x=\"");
+    svg_escreve_numero(f, x, 2);
+    svg_escreve_literal(f, "\" y=\"");
+    svg_escreve_numero(f, y, 2);
+    svg_escreve_literal(f, "\" fill=\"");
+    svg_escreve_texto(f, corp);
+    svg_escreve_literal(f, "\" stroke=\"");
+    svg_escreve_texto(f, corb);
+    svg_escreve_literal(f, "\" font-family=\"");
+    svg_escreve_texto(f, family_svg);
+    svg_escreve_literal(f, "\" font-weight=\"");
+    svg_escreve_texto(f, weight_svg);
+    svg_escreve_literal(f, "\" font-size=\"");
+    svg_escreve_numero(f, fSize, 1);
+    svg_escreve_literal(f, "px\" text-anchor=\"");
+    svg_escreve_texto(f, anr_str);
+    svg_escreve_literal(f, "\">");
+    svg_escreve_texto(f, txto);
+    svg_escreve_literal(f, "</text>\n");
 }
 
-void svg_desenha_asterisco(FILE* f, double x, double y) {
+void svg_desenha_asterisco(EscritorSvg f, double x, double y) {
     if (f == NULL) return;
-    fprintf(f, "\t<text x=\"%.2f\" y=\"%.2f\" fill=\"red\" font-weight=\"bold\" font-size=\"20px\" text-anchor=\"middle\">*</text>\n", x, y);
+    svg_escreve_literal(f, "\t<text x=\"");
+    svg_escreve_numero(f, x, 2);
+    svg_escreve_literal(f, "\" y=\"");
+    svg_escreve_numero(f, y, 2);
+    svg_escreve_literal(f, "\" fill=\"red\" font-weight=\"bold\" font-size=\"20px\" text-anchor=\"middle\">*</text>\n");
+}
+
+// Segmento pontilhado da trajetória
+static void desenha_tracejado(EscritorSvg f, double x1, double y1, double x2, double y2) {
+    svg_escreve_literal(f, "\t<line x1=\"");
+    svg_escreve_numero(f, x1, 2);
+    svg_escreve_literal(f, "\" y1=\"");
+    svg_escreve_numero(f, y1, 2);
+    svg_escreve_literal(f, "\" x2=\"");
+    svg_escreve_numero(f, x2, 2);
+    svg_escreve_literal(f, "\" y2=\"");
+    svg_escreve_numero(f, y2, 2);
+    svg_escreve_literal(f, "\" stroke=\"blue\" stroke-width=\"1.5\" stroke-dasharray=\"5,5\" opacity=\"0.6\" />\n");
 }
 
-void svg_desenha_trajetoria(FILE* f, double x1, double y1, double x2, double y2) {
+void svg_desenha_trajetoria(EscritorSvg f, double x1, double y1, double x2, double y2) {
     if (f == NULL) return;
     
-    fprintf(f, "\t<line x1=\"%.2f\" y1=\"%.2f\" x2=\"%.2f\" y2=\"%.2f\" ""stroke=\"blue\" stroke-width=\"1.5\" stroke-dasharray=\"5,5\" ""opacity=\"0.6\" />\n", x1, y1, x2, y1);
-    
-    fprintf(f, "\t<line x1=\"%.2f\" y1=\"%.2f\" x2=\"%.2f\" y2=\"%.2f\" ""stroke=\"blue\" stroke-width=\"1.5\" stroke-dasharray=\"5,5\" ""opacity=\"0.6\" />\n", x2, y1, x2, y2); 
-}
\ No newline at end of file
+    desenha_tracejado(f, x1, y1, x2, y1);
+    desenha_tracejado(f, x2, y1, x2, y2);
+}
+
+
+/*=========================*/
+/* Grupos Reutilizáveis    */
+/*=========================*/
+
+void svg_abre_grupo(EscritorSvg f, const char* id) {
+    if (f == NULL) return;
+    svg_escreve_literal(f, "\t<defs><g id=\"");
+    svg_escreve_texto(f, id);
+    svg_escreve_literal(f, "\">\n");
+}
+
+void svg_fecha_grupo(EscritorSvg f) {
+    if (f == NULL) return;
+    svg_escreve_literal(f, "\t</g></defs>\n");
+}
+
+// O href do SVG 2 e o xlink:href do SVG 1.1, para visualizadores que só conhecem um deles.
+void svg_usa_grupo(EscritorSvg f, const char* id) {
+    if (f == NULL) return;
+    svg_escreve_literal(f, "\t<use href=\"#");
+    svg_escreve_texto(f, id);
+    svg_escreve_literal(f, "\" xlink:href=\"#");
+    svg_escreve_texto(f, id);
+    svg_escreve_literal(f, "\" />\n");
+}
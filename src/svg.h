@@ -2,29 +2,64 @@
 #define SVG_H
 
 #include <stdio.h>
+#include <stddef.h>
 
 /*
 * Módulo de Geração de SVG.
 *
 * Este módulo fornece funções primitivas para criar um arquivo SVG
 * e desenhar formas básicas (círculo, retângulo, linha, texto).
+* Toda a escrita passa por um EscritorSvg: trechos literais copiados com memcpy para
+* os blocos da Saida (gravados em disco por uma thread própria) e números formatados
+* por uma rotina própria de casas decimais fixas, com o mesmo texto que o "%.2f" do
+* printf, mas sem o custo do fprintf.
 */
 
+/*
+* Declaração opaca do escritor de SVG.
+*/
+typedef void* EscritorSvg;
 
 /**
  * @brief Abre um arquivo SVG para escrita e escreve o cabeçalho.
  * @param path_svg O caminho completo do arquivo a ser criado (ex: "saida/geo.svg").
- * @return FILE* O ponteiro para o arquivo aberto, ou NULL em caso de erro.
+ * @param comprimido 1 para gravar um .svgz (gzip comprimido durante a escrita), 0 para SVG puro.
+ * @return EscritorSvg O escritor do arquivo aberto, ou NULL em caso de erro.
  */
-FILE* svg_inicia(const char* path_svg);
+EscritorSvg svg_inicia(const char* path_svg, int comprimido);
 
 /**
- * @brief Escreve a tag de fechamento </svg> e fecha o arquivo.
- * @param svg_file O ponteiro do arquivo retornado por svg_inicia.
+ * @brief Escreve a tag de fechamento </svg>, espera a gravação em segundo plano terminar
+ * e fecha o arquivo (finalizando o fluxo gzip, se comprimido).
+ * @param svg O escritor retornado por svg_inicia.
  */
-void svg_finaliza(FILE* svg_file);
+void svg_finaliza(EscritorSvg svg);
 
 
+/*=========================*/
+/* Escrita de Baixo Nível  */
+/*=========================*/
+
+/**
+ * @brief Acrescenta 'n' bytes à saída.
+ */
+void svg_escreve_bytes(EscritorSvg svg, const char* s, size_t n);
+
+/*
+* Acrescenta um literal de string, com o tamanho calculado em tempo de compilação.
+*/
+#define svg_escreve_literal(svg, literal) svg_escreve_bytes((svg), (literal), sizeof(literal) - 1)
+
+/**
+ * @brief Acrescenta uma string terminada em '\0' (NULL é escrito como "(null)", como no printf).
+ */
+void svg_escreve_texto(EscritorSvg svg, const char* s);
+
+/**
+ * @brief Acrescenta um número com 'casas' decimais (0 a 3), idêntico ao "%.Nf" do printf.
+ */
+void svg_escreve_numero(EscritorSvg svg, double valor, int casas);
+
 /*=========================*/
 /* Funções Primitivas de Desenho */
 /*=========================*/
@@ -32,38 +67,59 @@ void svg_finaliza(FILE* svg_file);
 /**
  * @brief Desenha um círculo no arquivo SVG.
  */
-void svg_desenha_circulo(FILE* f, double x, double y, double r, char* corb, char* corp);
+void svg_desenha_circulo(EscritorSvg svg, double x, double y, double r, char* corb, char* corp);
 
 /**
  * @brief Desenha um retângulo no arquivo SVG.
  */
-void svg_desenha_retangulo(FILE* f, double x, double y, double w, double h, char* corb, char* corp);
+void svg_desenha_retangulo(EscritorSvg svg, double x, double y, double w, double h, char* corb, char* corp);
 
 /**
  * @brief Desenha uma linha no arquivo SVG.
  */
-void svg_desenha_linha(FILE* f, double x1, double y1, double x2, double y2, char* cor);
+void svg_desenha_linha(EscritorSvg svg, double x1, double y1, double x2, double y2, char* cor);
 
 /**
  * @brief Desenha um texto no arquivo SVG.
  * @param anr A âncora do texto ('i', 'm', ou 'f').
  */
-void svg_desenha_texto(FILE* f, double x, double y, char* corb, char* corp, char* txto, char* fFamily, char* fWeight, double fSize, char anr);
+void svg_desenha_texto(EscritorSvg svg, double x, double y, char* corb, char* corp, char* txto, char* fFamily, char* fWeight, double fSize, char anr);
 
 /**
  * @brief Desenha um asterisco (anotação) no arquivo SVG.
  */
-void svg_desenha_asterisco(FILE* f, double x, double y);
+void svg_desenha_asterisco(EscritorSvg svg, double x, double y);
 
 /**
  * @brief Desenha uma linha pontilhada (trajetória de disparo) no SVG.
- * @param f O arquivo SVG.
+ * @param svg O escritor SVG.
  * @param x1 Coordenada X inicial (posição do disparador).
  * @param y1 Coordenada Y inicial (posição do disparador).
  * @param x2 Coordenada X final (posição da forma após disparo).
  * @param y2 Coordenada Y final (posição da forma após disparo).
  */
-void svg_desenha_trajetoria(FILE* f, double x1, double y1, double x2, double y2);
+void svg_desenha_trajetoria(EscritorSvg svg, double x1, double y1, double x2, double y2);
+
+/*=========================*/
+/* Grupos Reutilizáveis    */
+/*=========================*/
+
+/**
+ * @brief Abre um grupo dentro de <defs>: o que for desenhado até svg_fecha_grupo
+ * não aparece, só é definido para ser repetido com svg_usa_grupo.
+ * @param id Identificador único do grupo no arquivo.
+ */
+void svg_abre_grupo(EscritorSvg svg, const char* id);
+
+/**
+ * @brief Fecha o grupo aberto por svg_abre_grupo.
+ */
+void svg_fecha_grupo(EscritorSvg svg);
+
+/**
+ * @brief Desenha, nesta posição do arquivo, uma cópia do grupo definido com 'id'.
+ */
+void svg_usa_grupo(EscritorSvg svg, const char* id);
 
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,283 @@
+#include "tabelaFormas.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Colunas de cada tipo: círculo, retângulo, linha e texto.
+#define NUM_TIPOS_TABELA 4
+// Valores guardados por linha (o máximo entre os tipos: retângulo e linha usam 4).
+#define NUM_VALORES_TABELA 4
+// Capacidade inicial de cada tipo.
+#define CAPACIDADE_INICIAL_TABELA 64
+
+enum { COLUNA_CIRCULO, COLUNA_RETANGULO, COLUNA_LINHA, COLUNA_TEXTO };
+
+/*
+* Colunas de um tipo. v[0..3] são, por tipo:
+*   círculo: x, y, r | retângulo: x, y, w, h | linha: x1, y1, x2, y2 | texto: x, y
+*/
+typedef struct {
+    int n, capacidade;
+    int removidas;
+    double* v[NUM_VALORES_TABELA];
+    Forma* formas;
+    int* ordem;              // Posição relativa na lista (crescente dentro do tipo)
+    unsigned char* viva;
+    int* selecionadas;       // Resultado do filtro deste tipo (linhas)
+} ColunasTipo;
+
+typedef struct {
+    ColunasTipo tipos[NUM_TIPOS_TABELA];
+    int proxima_ordem;
+    int vivas;
+    RefFormaTabela* resultado;
+    int cap_resultado;
+} EstruturaTabela;
+
+static int coluna_do_tipo(char tipo) {
+    switch (tipo) {
+        case 'c': return COLUNA_CIRCULO;
+        case 'r': return COLUNA_RETANGULO;
+        case 'l': return COLUNA_LINHA;
+        case 't': return COLUNA_TEXTO;
+    }
+    return -1;
+}
+
+static int expande_colunas(ColunasTipo* c) {
+    int nova = c->capacidade == 0 ? CAPACIDADE_INICIAL_TABELA : c->capacidade * 2;
+
+    for (int k = 0; k < NUM_VALORES_TABELA; k++) {
+        double* v = (double*) realloc(c->v[k], (size_t) nova * sizeof(double));
+        if (v == NULL) return 0;
+        c->v[k] = v;
+    }
+    Forma* formas = (Forma*) realloc(c->formas, (size_t) nova * sizeof(Forma));
+    if (formas == NULL) return 0;
+    c->formas = formas;
+    int* ordem = (int*) realloc(c->ordem, (size_t) nova * sizeof(int));
+    if (ordem == NULL) return 0;
+    c->ordem = ordem;
+    unsigned char* viva = (unsigned char*) realloc(c->viva, (size_t) nova);
+    if (viva == NULL) return 0;
+    c->viva = viva;
+    int* selecionadas = (int*) realloc(c->selecionadas, (size_t) nova * sizeof(int));
+    if (selecionadas == NULL) return 0;
+    c->selecionadas = selecionadas;
+
+    c->capacidade = nova;
+    return 1;
+}
+
+static void libera_colunas(ColunasTipo* c) {
+    for (int k = 0; k < NUM_VALORES_TABELA; k++) {
+        free(c->v[k]);
+    }
+    free(c->formas);
+    free(c->ordem);
+    free(c->viva);
+    free(c->selecionadas);
+}
+
+/*
+* Remove de vez as linhas marcadas, mantendo a ordem das restantes.
+*/
+static void compacta_colunas(ColunasTipo* c) {
+    int m = 0;
+    for (int i = 0; i < c->n; i++) {
+        if (!c->viva[i]) continue;
+        for (int k = 0; k < NUM_VALORES_TABELA; k++) {
+            c->v[k][m] = c->v[k][i];
+        }
+        c->formas[m] = c->formas[i];
+        c->ordem[m] = c->ordem[i];
+        c->viva[m] = 1;
+        m++;
+    }
+    c->n = m;
+    c->removidas = 0;
+}
+
+TabelaFormas tabela_formas_cria(Lista formas) {
+    EstruturaTabela* tabela = (EstruturaTabela*) calloc(1, sizeof(EstruturaTabela));
+    if (tabela == NULL) {
+        printf("Erro ao alocar tabela de formas\n");
+        return NULL;
+    }
+
+    int n;
+    void** array = lista_para_array(formas, &n);
+    if (array != NULL) {
+        for (int i = 0; i < n; i++) {
+            tabela_formas_adiciona(tabela, (Forma) array[i]);
+        }
+        free(array);
+    }
+    return (TabelaFormas) tabela;
+}
+
+void tabela_formas_destroi(TabelaFormas t) {
+    EstruturaTabela* tabela = (EstruturaTabela*) t;
+    if (tabela == NULL) return;
+    for (int i = 0; i < NUM_TIPOS_TABELA; i++) {
+        libera_colunas(&tabela->tipos[i]);
+    }
+    free(tabela->resultado);
+    free(tabela);
+}
+
+void tabela_formas_adiciona(TabelaFormas t, Forma f) {
+    EstruturaTabela* tabela = (EstruturaTabela*) t;
+    DescricaoForma d;
+    if (tabela == NULL || f == NULL || !forma_descreve(f, &d)) return;
+
+    int tipo = coluna_do_tipo(d.tipo);
+    if (tipo < 0) return;
+
+    ColunasTipo* c = &tabela->tipos[tipo];
+    if (c->n == c->capacidade && !expande_colunas(c)) {
+        printf("Erro ao expandir tabela de formas\n");
+        return;
+    }
+
+    int i = c->n++;
+    for (int k = 0; k < NUM_VALORES_TABELA; k++) {
+        c->v[k][i] = d.v[k];
+    }
+    c->formas[i] = f;
+    c->ordem[i] = tabela->proxima_ordem++;
+    c->viva[i] = 1;
+    tabela->vivas++;
+}
+
+void tabela_formas_remove(TabelaFormas t, RefFormaTabela ref) {
+    EstruturaTabela* tabela = (EstruturaTabela*) t;
+    if (tabela == NULL || ref.tipo < 0 || ref.tipo >= NUM_TIPOS_TABELA) return;
+
+    ColunasTipo* c = &tabela->tipos[ref.tipo];
+    if (ref.linha < 0 || ref.linha >= c->n || !c->viva[ref.linha] || c->formas[ref.linha] != ref.forma) {
+        return;
+    }
+    c->viva[ref.linha] = 0;
+    c->removidas++;
+    tabela->vivas--;
+}
+
+int tabela_formas_tamanho(TabelaFormas t) {
+    EstruturaTabela* tabela = (EstruturaTabela*) t;
+    return tabela != NULL ? tabela->vivas : 0;
+}
+
+/*
+* Filtros por tipo. Cada um reproduz a caixa envolvente de forma_sobrepoe_visibilidade
+* e escreve as linhas aceitas em 'selecionadas' sem desvio por linha: o índice é sempre
+* escrito e o contador só avança quando a linha passa.
+*/
+static int filtra_circulos(ColunasTipo* c, double xmin, double ymin, double xmax, double ymax) {
+    const double *x = c->v[0], *y = c->v[1], *r = c->v[2];
+    int k = 0;
+    for (int i = 0; i < c->n; i++) {
+        int fora = (x[i] + r[i] < xmin) | (x[i] - r[i] > xmax) |
+                   (y[i] + r[i] < ymin) | (y[i] - r[i] > ymax);
+        c->selecionadas[k] = i;
+        k += c->viva[i] & !fora;
+    }
+    return k;
+}
+
+static int filtra_retangulos(ColunasTipo* c, double xmin, double ymin, double xmax, double ymax) {
+    const double *x = c->v[0], *y = c->v[1], *w = c->v[2], *h = c->v[3];
+    int k = 0;
+    for (int i = 0; i < c->n; i++) {
+        int fora = (x[i] + w[i] < xmin) | (x[i] > xmax) |
+                   (y[i] + h[i] < ymin) | (y[i] > ymax);
+        c->selecionadas[k] = i;
+        k += c->viva[i] & !fora;
+    }
+    return k;
+}
+
+static int filtra_linhas(ColunasTipo* c, double xmin, double ymin, double xmax, double ymax) {
+    const double *x1 = c->v[0], *y1 = c->v[1], *x2 = c->v[2], *y2 = c->v[3];
+    int k = 0;
+    for (int i = 0; i < c->n; i++) {
+        double menor_x = x1[i] < x2[i] ? x1[i] : x2[i];
+        double maior_x = x1[i] > x2[i] ? x1[i] : x2[i];
+        double menor_y = y1[i] < y2[i] ? y1[i] : y2[i];
+        double maior_y = y1[i] > y2[i] ? y1[i] : y2[i];
+        int fora = (maior_x < xmin) | (menor_x > xmax) | (maior_y < ymin) | (menor_y > ymax);
+        c->selecionadas[k] = i;
+        k += c->viva[i] & !fora;
+    }
+    return k;
+}
+
+static int filtra_textos(ColunasTipo* c, double xmin, double ymin, double xmax, double ymax) {
+    const double *x = c->v[0], *y = c->v[1];
+    int k = 0;
+    for (int i = 0; i < c->n; i++) {
+        int fora = (x[i] + 100 < xmin) | (x[i] - 100 > xmax) |
+                   (y[i] + 20 < ymin) | (y[i] - 20 > ymax);
+        c->selecionadas[k] = i;
+        k += c->viva[i] & !fora;
+    }
+    return k;
+}
+
+RefFormaTabela* tabela_formas_candidatas(TabelaFormas t, double xmin, double ymin,
+                                         double xmax, double ymax, int* n) {
+    EstruturaTabela* tabela = (EstruturaTabela*) t;
+    *n = 0;
+    if (tabela == NULL) return NULL;
+
+    int contagem[NUM_TIPOS_TABELA];
+    int total = 0;
+    for (int tipo = 0; tipo < NUM_TIPOS_TABELA; tipo++) {
+        ColunasTipo* c = &tabela->tipos[tipo];
+        if (2 * c->removidas > c->n) {
+            compacta_colunas(c);
+        }
+        switch (tipo) {
+            case COLUNA_CIRCULO:   contagem[tipo] = filtra_circulos(c, xmin, ymin, xmax, ymax); break;
+            case COLUNA_RETANGULO: contagem[tipo] = filtra_retangulos(c, xmin, ymin, xmax, ymax); break;
+            case COLUNA_LINHA:     contagem[tipo] = filtra_linhas(c, xmin, ymin, xmax, ymax); break;
+            default:               contagem[tipo] = filtra_textos(c, xmin, ymin, xmax, ymax); break;
+        }
+        total += contagem[tipo];
+    }
+
+    if (total > tabela->cap_resultado) {
+        RefFormaTabela* novo = (RefFormaTabela*) realloc(tabela->resultado, (size_t) total * sizeof(RefFormaTabela));
+        if (novo == NULL) {
+            printf("Erro ao alocar resultado da tabela de formas\n");
+            return NULL;
+        }
+        tabela->resultado = novo;
+        tabela->cap_resultado = total;
+    }
+
+    // Intercala os quatro tipos pela ordem da lista (cada tipo já está em ordem)
+    int pos[NUM_TIPOS_TABELA] = {0, 0, 0, 0};
+    for (int k = 0; k < total; k++) {
+        int escolhido = -1;
+        int menor = 0;
+        for (int tipo = 0; tipo < NUM_TIPOS_TABELA; tipo++) {
+            if (pos[tipo] < contagem[tipo]) {
+                ColunasTipo* c = &tabela->tipos[tipo];
+                int ordem = c->ordem[c->selecionadas[pos[tipo]]];
+                if (escolhido < 0 || ordem < menor) {
+                    escolhido = tipo;
+                    menor = ordem;
+                }
+            }
+        }
+        ColunasTipo* c = &tabela->tipos[escolhido];
+        int linha = c->selecionadas[pos[escolhido]++];
+        tabela->resultado[k].forma = c->formas[linha];
+        tabela->resultado[k].tipo = escolhido;
+        tabela->resultado[k].linha = linha;
+    }
+
+    *n = total;
+    return tabela->resultado;
+}
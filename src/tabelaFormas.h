@@ -0,0 +1,71 @@
+#ifndef TABELAFORMAS_H
+#define TABELAFORMAS_H
+
+#include "lista.h"
+#include "formas.h"
+
+/*
+* TAD Tabela de Formas (representação colunar da cena).
+* Fica ao lado da lista de formas e guarda a geometria de cada tipo em colunas separadas
+* (estrutura de arrays): círculos (x, y, r), retângulos (x, y, w, h), linhas (x1, y1, x2, y2)
+* e textos (x, y). Consultas em massa, como o filtro por caixa envolvente das bombas,
+* viram laços simples sobre arrays contíguos de cada tipo, sem seguir ponteiros nem
+* testar o tipo de cada forma.
+*
+* Cada linha guarda também a ordem da forma na lista, e as consultas devolvem as formas
+* nessa ordem. Para isso, formas novas devem ser acrescentadas no fim da lista e da tabela.
+* Formas removidas só são marcadas e a tabela é compactada depois, em uma consulta.
+*/
+
+typedef void* TabelaFormas;
+
+/*
+* Referência a uma forma dentro da tabela, devolvida pelas consultas.
+* Vale até a próxima consulta (que pode compactar a tabela).
+*/
+typedef struct {
+    Forma forma;
+    int tipo;                // Coluna da forma (uso interno)
+    int linha;               // Linha na coluna (uso interno)
+} RefFormaTabela;
+
+/**
+ * @brief Cria a tabela com as formas da lista, na ordem da lista.
+ * @param formas A lista de formas.
+ * @return TabelaFormas A tabela criada, ou NULL em caso de erro.
+ */
+TabelaFormas tabela_formas_cria(Lista formas);
+
+/**
+ * @brief Destrói a tabela (as formas não são destruídas).
+ */
+void tabela_formas_destroi(TabelaFormas tabela);
+
+/**
+ * @brief Acrescenta uma forma no fim da tabela (a mesma forma deve ir para o fim da lista).
+ */
+void tabela_formas_adiciona(TabelaFormas tabela, Forma f);
+
+/**
+ * @brief Marca como removida a forma de uma referência obtida na última consulta.
+ */
+void tabela_formas_remove(TabelaFormas tabela, RefFormaTabela ref);
+
+/**
+ * @brief Seleciona as formas cuja caixa envolvente toca a caixa [xmin, xmax] x [ymin, ymax].
+ * Usa as mesmas caixas de forma_sobrepoe_visibilidade, então nenhuma forma que esse
+ * teste aceitaria fica de fora.
+ * @param tabela A tabela.
+ * @param n Onde escrever o número de formas selecionadas.
+ * @return RefFormaTabela* As formas na ordem da lista. O array pertence à tabela e vale
+ * até a próxima consulta.
+ */
+RefFormaTabela* tabela_formas_candidatas(TabelaFormas tabela, double xmin, double ymin,
+                                         double xmax, double ymax, int* n);
+
+/**
+ * @brief Retorna o número de formas na tabela (sem contar as removidas).
+ */
+int tabela_formas_tamanho(TabelaFormas tabela);
+
+#endif
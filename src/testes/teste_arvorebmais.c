@@ -0,0 +1,86 @@
+#include "../arvorebmais.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+* Teste de regressão da remoção na árvore B+: insere 0..N-1, remove em ordem aleatória
+* e libera cada elemento devolvido logo em seguida, como fazem os chamadores. Antes de
+* liberar, o valor é trocado por uma marca; se algum separador interno ainda apontar
+* para o elemento, a comparação seguinte encontra a marca (ou o AddressSanitizer acusa
+* o acesso à memória liberada, com 'make teste').
+* Uso: teste_arvorebmais   (executado por 'make teste')
+*/
+
+#define N_ELEMENTOS 2000
+#define MARCA_LIBERADO -1
+#define SEMENTE 12345
+
+static int falhas = 0;
+
+static int compara_int(void* a, void* b, void* contexto) {
+    (void) contexto;
+    int x = *(int*)a, y = *(int*)b;
+    if (x == MARCA_LIBERADO || y == MARCA_LIBERADO) {
+        printf("Erro: comparação com elemento já removido\n");
+        exit(1);
+    }
+    return (x > y) - (x < y);
+}
+
+static void verifica(int condicao, const char* mensagem, int valor) {
+    if (!condicao) {
+        printf("Erro: %s (%d)\n", mensagem, valor);
+        falhas++;
+    }
+}
+
+int main() {
+    ArvoreBMais arv = arvorebmais_cria(compara_int, NULL);
+    if (arv == NULL) return 1;
+
+    for (int i = 0; i < N_ELEMENTOS; i++) {
+        int* v = (int*) malloc(sizeof(int));
+        if (v == NULL) return 1;
+        *v = i;
+        arvorebmais_insere(arv, v);
+    }
+    verifica(arvorebmais_tamanho(arv) == N_ELEMENTOS, "tamanho após inserir", arvorebmais_tamanho(arv));
+
+    int ordem[N_ELEMENTOS];
+    for (int i = 0; i < N_ELEMENTOS; i++) {
+        ordem[i] = i;
+    }
+    srand(SEMENTE);
+    for (int i = N_ELEMENTOS - 1; i > 0; i--) {
+        int j = rand() % (i + 1);
+        int t = ordem[i];
+        ordem[i] = ordem[j];
+        ordem[j] = t;
+    }
+
+    for (int k = 0; k < N_ELEMENTOS; k++) {
+        int chave = ordem[k];
+        int* removido = (int*) arvorebmais_remove(arv, &chave);
+        verifica(removido != NULL && *removido == chave, "remoção não devolveu o elemento", chave);
+        if (removido != NULL) {
+            *removido = MARCA_LIBERADO;
+            free(removido);
+        }
+
+        verifica(arvorebmais_busca(arv, &chave) == NULL, "elemento removido ainda encontrado", chave);
+        verifica(arvorebmais_tamanho(arv) == N_ELEMENTOS - k - 1, "tamanho após remover", chave);
+        if (k + 1 < N_ELEMENTOS) {
+            int proxima = ordem[k + 1];
+            int* achado = (int*) arvorebmais_busca(arv, &proxima);
+            verifica(achado != NULL && *achado == proxima, "elemento restante não encontrado", proxima);
+        }
+    }
+
+    arvorebmais_destroi(arv);
+    if (falhas > 0) {
+        printf("teste_arvorebmais: %d falha(s)\n", falhas);
+        return 1;
+    }
+    printf("teste_arvorebmais: ok\n");
+    return 0;
+}
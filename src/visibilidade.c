@@ -1,7 +1,8 @@
 #include "poligono.h"
 #include "geometria.h"
 #include "anteparo.h"
-#include "lista.h"
+#include "visibilidade.h"
+#include "ordenacao_tipada.h"
 #include <math.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -14,43 +15,60 @@ typedef struct {
     double angulo;
 } RaioAngulo;
 
-static int compara_angulos(const void* a, const void* b) {
-    const RaioAngulo* ra = (const RaioAngulo*)a;
-    const RaioAngulo* rb = (const RaioAngulo*)b;
-    
-    if (ra->angulo < rb->angulo) return -1;
-    if (ra->angulo > rb->angulo) return 1;
-    return 0;
-}
+// Ordenação especializada dos raios por ângulo (gera angulos_pdqsort etc.)
+#define MENOR_ANGULO(a, b) ((a).angulo < (b).angulo)
+ORDENACAO_DEFINE(angulos, RaioAngulo, MENOR_ANGULO)
+
+/*
+* Folga da rejeição por caixa envolvente. Uma interseção aceita pelo teste abaixo pode
+* cair até EPSILON * |segmento| fora do segmento (tolerância em s), mais o erro de
+* arredondamento; com esta folga a rejeição nunca descarta um anteparo que seria atingido.
+*/
+#define FOLGA_CAIXA 1e-6
 
 static int encontra_interseccao_mais_proxima(double px, double py, double dir_x, double dir_y,
-                                             Lista anteparos,
-                                             double* ix, double* iy) {
+                                             const VistaAnteparos* v, double folga,
+                                             double* ix, double* iy, long long* testes) {
     double t_min = 1e20;
     int encontrou = 0;
     
-    int n;
-    void** arr = lista_para_array(anteparos, &n);
-    
-    if (arr != NULL) {
-        for (int i = 0; i < n; i++) {
-            Anteparo ant = (Anteparo)arr[i];
-            double isx, isy;
-            
-            if (geometria_raio_intersecta_anteparo(px, py, dir_x, dir_y, ant, &isx, &isy)) {
-                double dist = (isx - px) * (isx - px) + (isy - py) * (isy - py);
-                if (dist > EPSILON) {
-                    double t = sqrt(dist);
-                    if (t < t_min) {
-                        t_min = t;
-                        *ix = isx;
-                        *iy = isy;
-                        encontrou = 1;
-                    }
-                }
+    // Caixas inteiramente atrás do raio (em x ou em y) não podem ser atingidas
+    int para_direita = dir_x >= 0, para_esquerda = dir_x <= 0;
+    int para_cima = dir_y >= 0, para_baixo = dir_y <= 0;
+    
+    for (int i = 0; i < v->n; i++) {
+        int atras = (para_direita & (v->xmax[i] + folga < px)) |
+                    (para_esquerda & (v->xmin[i] - folga > px)) |
+                    (para_cima & (v->ymax[i] + folga < py)) |
+                    (para_baixo & (v->ymin[i] - folga > py));
+        if (atras) continue;
+        (*testes)++;
+        
+        // Raio P + t*D contra o segmento A + s*(B-A), com B-A já calculado no conjunto
+        // (mesmas contas de geometria_raio_intersecta_segmento)
+        double sx = v->dx[i];
+        double sy = v->dy[i];
+        double denom = dir_x * sy - dir_y * sx;
+        if (fabs(denom) < EPSILON) continue;
+        
+        double ax = v->x1[i] - px;
+        double ay = v->y1[i] - py;
+        double t = (ax * sy - ay * sx) / denom;
+        double s = (ax * dir_y - ay * dir_x) / denom;
+        if (!(t >= -EPSILON && s >= -EPSILON && s <= 1.0 + EPSILON)) continue;
+        
+        double isx = px + t * dir_x;
+        double isy = py + t * dir_y;
+        double dist = (isx - px) * (isx - px) + (isy - py) * (isy - py);
+        if (dist > EPSILON) {
+            double d = sqrt(dist);
+            if (d < t_min) {
+                t_min = d;
+                *ix = isx;
+                *iy = isy;
+                encontrou = 1;
             }
         }
-        free(arr);
     }
     
     // Testa intersecção com retângulo envolvente
@@ -107,17 +125,18 @@ static int encontra_interseccao_mais_proxima(double px, double py, double dir_x,
     return encontrou;
 }
 
-Poligono calcula_regiao_visibilidade(double px, double py, Lista anteparos) {
+Poligono calcula_regiao_visibilidade_conjunto(double px, double py, ConjuntoAnteparos anteparos,
+                                              ContagemVisibilidade* contagem) {
     Poligono vis = poligono_cria();
-    if (vis == NULL || anteparos == NULL) {
+    if (vis == NULL) {
         return vis;
     }
     
-    int n_ant;
-    void** arr_ant = lista_para_array(anteparos, &n_ant);
+    VistaAnteparos v;
+    conjunto_anteparos_vista(anteparos, &v);
+    int n_ant = v.n;
     
     if (n_ant == 0) {
-        if (arr_ant) free(arr_ant);
         poligono_adiciona_vertice(vis, -100, -100);
         poligono_adiciona_vertice(vis, 1100, -100);
         poligono_adiciona_vertice(vis, 1100, 800);
@@ -125,15 +144,14 @@ Poligono calcula_regiao_visibilidade(double px, double py, Lista anteparos) {
         return vis;
     }
     
+    double folga = FOLGA_CAIXA + EPSILON * v.maior_extensao;
     
     #define MAX_ANGULOS 3000
     RaioAngulo angulos[MAX_ANGULOS];
     int n_ang = 0;
 
     for (int i = 0; i < n_ant && n_ang + 6 < MAX_ANGULOS; i++) {
-        Anteparo ant = (Anteparo)arr_ant[i];
-        double x1, y1, x2, y2;
-        anteparo_getCoordenadas(ant, &x1, &y1, &x2, &y2);
+        double x1 = v.x1[i], y1 = v.y1[i], x2 = v.x2[i], y2 = v.y2[i];
         
         // Ângulo do vértice inicial
         double ang1 = atan2(y1 - py, x1 - px);
@@ -184,7 +202,7 @@ Poligono calcula_regiao_visibilidade(double px, double py, Lista anteparos) {
     }
     
     // Ordena por ângulo
-    qsort(angulos, n_ang, sizeof(RaioAngulo), compara_angulos);
+    angulos_pdqsort(angulos, n_ang);
     
     // Remove duplicatas muito próximas
     RaioAngulo angulos_unicos[MAX_ANGULOS];
@@ -198,18 +216,22 @@ Poligono calcula_regiao_visibilidade(double px, double py, Lista anteparos) {
     }
     
     // Para cada ângulo, traça raio e encontra interseção
+    long long testes = 0;
     for (int i = 0; i < n_unicos; i++) {
         double ang = angulos_unicos[i].angulo;
         double dir_x = cos(ang);
         double dir_y = sin(ang);
         
         double ix, iy;
-        if (encontra_interseccao_mais_proxima(px, py, dir_x, dir_y, anteparos, &ix, &iy)) {
+        if (encontra_interseccao_mais_proxima(px, py, dir_x, dir_y, &v, folga, &ix, &iy, &testes)) {
             poligono_adiciona_vertice(vis, ix, iy);
         }
     }
     
-    if (arr_ant) free(arr_ant);
+    if (contagem != NULL) {
+        contagem->raios += n_unicos;
+        contagem->testes += testes;
+    }
     
     return vis;
 }
\ No newline at end of file
@@ -2,21 +2,32 @@
 #define VISIBILIDADE_H
 
 #include "poligono.h"
-#include "lista.h"
+#include "anteparo.h"
+
+/*
+* Trabalho feito em um cálculo de visibilidade (para --stats).
+*/
+typedef struct {
+    long long raios;         // Raios traçados
+    long long testes;        // Testes exatos raio-anteparo (os que passaram do filtro por caixa)
+} ContagemVisibilidade;
 
 /**
  * @brief Calcula a região de visibilidade a partir de um ponto.
- * 
+ *
  * Implementa o algoritmo de varredura angular descrito no PDF
- * point-vis-region.pdf. Dado um ponto (bomba) e uma lista de
+ * point-vis-region.pdf. Dado um ponto (bomba) e um conjunto de
  * anteparos (segmentos bloqueantes), retorna um polígono que
  * representa a região iluminada/visível.
- * 
+ * Os raios percorrem os arrays do conjunto direto, e várias bombas podem usar o mesmo
+ * conjunto. Não altera o conjunto; pode ser chamada de várias threads.
  * @param x Coordenada X da bomba.
  * @param y Coordenada Y da bomba.
- * @param anteparos Lista de anteparos (TAD Anteparo).
+ * @param anteparos Conjunto de anteparos.
+ * @param contagem Onde somar o trabalho feito (pode ser NULL).
  * @return Poligono Região de visibilidade, ou NULL em caso de erro.
  */
-Poligono calcula_regiao_visibilidade(double x, double y, Lista anteparos);
+Poligono calcula_regiao_visibilidade_conjunto(double x, double y, ConjuntoAnteparos anteparos,
+                                              ContagemVisibilidade* contagem);
 
 #endif
\ No newline at end of file